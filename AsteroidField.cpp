@@ -0,0 +1,148 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#include "AsteroidField.h"
+#include "Memory.h"
+#include <cmath>
+
+// SplitMix64: cheap, and good enough that neighbouring tile coordinates give unrelated fields
+static uint64_t mix(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+struct TileRandom
+{
+    uint64_t m_state;
+
+    TileRandom(uint32_t seed, int tile_x, int tile_y)
+    {
+        uint64_t coordinates = (uint64_t)(uint32_t)tile_x | ((uint64_t)(uint32_t)tile_y << 32);
+        m_state = mix(seed ^ mix(coordinates));
+    }
+
+    // Uniform in [0, 1)
+    float next()
+    {
+        m_state = mix(m_state);
+        return (float)(m_state >> 40) / (float)(1 << 24);
+    }
+};
+
+AsteroidField::~AsteroidField()
+{
+    stop();
+}
+
+void AsteroidField::start(FieldSettings settings, int max_in_flight)
+{
+    stop();
+
+    m_requests.reserve(max_in_flight);
+    m_finished.reserve(max_in_flight);
+    m_settings = settings;
+    m_stopping = false;
+    m_worker = std::thread(&AsteroidField::work, this);
+}
+
+void AsteroidField::stop()
+{
+    if (!m_worker.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+
+    release_container(m_requests);
+    release_container(m_finished);
+}
+
+void AsteroidField::request(FieldTile* tile)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back(tile);
+    }
+    m_wake.notify_one();
+}
+
+bool AsteroidField::collect(FieldTile*& tile)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished.empty()) return false;
+
+    tile = m_finished.back();
+    m_finished.pop_back();
+    return true;
+}
+
+void AsteroidField::work()
+{
+    MemoryScope scope(MEMORY_WORLD);
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_wake.wait(lock, [this] { return m_stopping || !m_requests.empty(); });
+        if (m_stopping) return;
+
+        FieldTile* tile = m_requests.back();
+        m_requests.pop_back();
+
+        // Generate without holding the lock so the game thread never waits on us
+        lock.unlock();
+        generate(m_settings, *tile);
+        lock.lock();
+
+        m_finished.push_back(tile);
+    }
+}
+
+void AsteroidField::generate(const FieldSettings& settings, FieldTile& tile)
+{
+    TileRandom random(settings.seed, tile.x, tile.y);
+
+    tile.asteroids.clear();
+
+    // Every candidate draws the same numbers whether it is kept or not, so a
+    // tile looks the same no matter which keep-outs were passed in with it
+    int count = (int)(random.next() * (settings.max_per_tile + 1));
+
+    for (int i = 0; i < count; i++)
+    {
+        Asteroid asteroid;
+        asteroid.x = (tile.x + random.next()) * settings.tile_size;
+        asteroid.y = (tile.y + random.next()) * settings.tile_size;
+        asteroid.size = settings.min_size + random.next() * (settings.max_size - settings.min_size);
+        asteroid.angle = random.next() * 6.2831853f;
+        asteroid.mass = asteroid.size * asteroid.size;
+
+        bool blocked = false;
+        for (const KeepOut& keep_out : tile.keep_outs)
+        {
+            float reach = keep_out.radius + asteroid.size * 0.5f;
+            float x_distance = asteroid.x - keep_out.x;
+            float y_distance = asteroid.y - keep_out.y;
+            if (x_distance * x_distance + y_distance * y_distance < reach * reach)
+            {
+                blocked = true;
+                break;
+            }
+        }
+
+        if (!blocked) tile.asteroids.push_back(asteroid);
+    }
+}
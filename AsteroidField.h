@@ -0,0 +1,81 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct FieldSettings
+{
+    uint32_t seed = 0;
+    float tile_size = 1.0f;
+    int   max_per_tile = 0;
+    float min_size = 0.5f,
+          max_size = 1.0f;
+};
+
+struct Asteroid
+{
+    float x, y;
+    float size;
+    float angle;
+    float mass;
+};
+
+// Circle no asteroid may overlap, e.g. around a platform or the player's start
+struct KeepOut
+{
+    float x, y;
+    float radius;
+};
+
+struct FieldTile
+{
+    int x, y;
+    uint32_t ticket = 0;        // lets the requester tell a stale result from the one it still wants
+    std::vector<KeepOut> keep_outs;
+    std::vector<Asteroid> asteroids;
+};
+
+// Generates asteroid tiles on a background thread. A tile's contents depend only
+// on the seed and its coordinates, so tiles can be dropped and regenerated freely.
+// Tiles are owned and recycled by the caller; only pointers pass through the queues,
+// which are sized up front so requesting and collecting never allocate.
+class AsteroidField
+{
+private:
+    FieldSettings m_settings;
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::vector<FieldTile*> m_requests;     // newest first out, as the camera most likely still wants it
+    std::vector<FieldTile*> m_finished;
+    bool m_stopping = false;
+
+    void work();
+
+public:
+    ~AsteroidField();
+
+    // max_in_flight is the most tiles the caller will ever have requested and not collected
+    void start(FieldSettings settings, int max_in_flight);
+    void stop();
+
+    // Queues a tile for generation; collect() hands it back once it is done. Tiles
+    // still queued when the field stops are simply dropped, the caller owns them.
+    void request(FieldTile* tile);
+    bool collect(FieldTile*& tile);
+
+    // Fills tile.asteroids; safe to call from any thread
+    static void generate(const FieldSettings& settings, FieldTile& tile);
+};
@@ -0,0 +1,424 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#define GL_SILENCE_DEPRECATION
+
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL.h>
+#include <SDL_opengl.h>
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "ShaderProgram.h"
+#include "Entity.h"
+#include "Memory.h"
+#include "Autopilot.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// Plans that never reach the goal must always cost more than any landing,
+// and a crash more than simply running out of horizon
+const float MISSED_COST = 10000.0f;
+const float CRASHED_COST = 20000.0f;
+const float DISTANCE_WEIGHT = 500.0f;
+const float SPEED_WEIGHT = 100.0f;
+
+// How far each refit moves the distribution towards the elites, and how
+// unlikely any choice is allowed to become so we keep exploring
+const float SMOOTHING = 0.7f;
+const float MIN_CHANCE = 0.05f;
+
+void apply_controls(Entity* lander, Controls controls, float gravity)
+{
+    lander->set_movement(glm::vec3(0.0f));
+    lander->set_acceleration(glm::vec3(0.0f, gravity, 0.0f));
+    lander->set_angle_speed(glm::radians(TURN_SPEED * controls.turn));
+
+    if (controls.thrust)
+    {
+        lander->set_acceleration(glm::vec3(-THRUST_ACCELERATION * glm::sin(lander->get_angle()), THRUST_ACCELERATION * glm::cos(lander->get_angle()), 0.0f));
+    }
+}
+
+Autopilot::Autopilot(float time_step, float gravity)
+{
+    m_time_step = time_step;
+    m_gravity = gravity;
+    m_thread_count = std::max(1, (int)std::thread::hardware_concurrency());
+
+    // Fixed seed so stress runs are repeatable
+    m_rng.seed(2023);
+
+    reset();
+}
+
+bool Autopilot::start(int collidable_capacity)
+{
+    if (m_planner.joinable()) return false;
+
+    MemoryScope scope(MEMORY_PLANNER);
+
+    // Everything a search touches is allocated here, so planning never hits the heap
+    m_population.resize(AUTOPILOT_POPULATION * AUTOPILOT_SEGMENTS);
+    m_costs.resize(AUTOPILOT_POPULATION);
+    m_order.resize(AUTOPILOT_POPULATION);
+    m_search.collidables.reserve(collidable_capacity);
+    m_refine_collidables.reserve(collidable_capacity);
+
+    // The planner thread takes the first slice of every batch, the workers the rest
+    m_planner = std::thread(&Autopilot::run_planner, this);
+    for (int t = 1; t < m_thread_count; t++)
+    {
+        m_workers.emplace_back(&Autopilot::work, this, t);
+    }
+
+    return true;
+}
+
+Autopilot::~Autopilot()
+{
+    if (!m_planner.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    // Workers that see the flag quit without reporting their slice, so the planner may
+    // be left waiting on a batch that will never finish; wake it as well
+    m_batch_ready.notify_all();
+    m_batch_done.notify_all();
+    m_search_ready.notify_one();
+
+    m_planner.join();
+    for (std::thread& worker : m_workers) worker.join();
+}
+
+void Autopilot::reset()
+{
+    for (int i = 0; i < AUTOPILOT_SEGMENTS; i++) m_plan[i] = Controls();
+    m_step_in_segment = 0;
+    m_restart = true;
+
+    // Skip a boundary, so a search still running from before can never match the next one
+    m_segment++;
+}
+
+void Autopilot::reset_distribution(int segment)
+{
+    m_thrust_chance[segment] = 0.5f;
+    for (int j = 0; j < 3; j++) m_turn_chance[segment][j] = 1.0f / 3.0f;
+}
+
+Controls Autopilot::next_controls(const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel)
+{
+    start(collidable_count);
+
+    if (m_step_in_segment == 0)
+    {
+        begin_segment(lander, collidables, collidable_count, target, fuel);
+    }
+
+    Controls controls = m_plan[0];
+    if (fuel <= 0) controls.thrust = false;
+
+    m_step_in_segment++;
+    if (m_step_in_segment >= AUTOPILOT_SEGMENT_STEPS)
+    {
+        m_step_in_segment = 0;
+
+        // Shift the plan forward one segment, in case the next search is late
+        for (int i = 0; i < AUTOPILOT_SEGMENTS - 1; i++) m_plan[i] = m_plan[i + 1];
+        m_plan[AUTOPILOT_SEGMENTS - 1] = Controls();
+    }
+
+    return controls;
+}
+
+void Autopilot::begin_segment(const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel)
+{
+    m_segment++;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // STEP 1: Take the plan searched for this boundary, if it is ready; a late one is dropped
+    if (m_search_state == SEARCH_DONE)
+    {
+        if (m_search.segment == m_segment) std::copy(m_search.plan, m_search.plan + AUTOPILOT_SEGMENTS, m_plan);
+        m_search_state = SEARCH_IDLE;
+    }
+
+    // STEP 2: Start searching for the next boundary while this segment is flown
+    if (m_search_state != SEARCH_IDLE) return;
+
+    m_search.lander = *lander;
+    m_search.flying = m_plan[0];
+    m_search.collidables.assign(collidables, collidables + collidable_count);
+    m_search.target = target;
+    m_search.fuel = fuel;
+    m_search.segment = m_segment + 1;
+    m_search.restart = m_restart;
+
+    std::copy(m_plan + 1, m_plan + AUTOPILOT_SEGMENTS, m_search.plan);
+    m_search.plan[AUTOPILOT_SEGMENTS - 1] = Controls();
+
+    m_restart = false;
+    m_search_state = SEARCH_QUEUED;
+    m_search_ready.notify_one();
+}
+
+void Autopilot::run_planner()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_search_ready.wait(lock, [this] { return m_stopping || m_search_state == SEARCH_QUEUED; });
+            if (m_stopping) return;
+            m_search_state = SEARCH_RUNNING;
+        }
+
+        search();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_search_state = SEARCH_DONE;
+        }
+
+        if (m_sustained) refine();
+    }
+}
+
+void Autopilot::refine()
+{
+    // The finished plan now belongs to the game thread, so keep searching on copies.
+    // Every search seeds its population with the best plan so far, so a result can only improve.
+    while (true)
+    {
+        replan(m_refine_plan, &m_refine_lander, m_refine_collidables.data(), (int)m_refine_collidables.size(), m_refine_target, m_refine_fuel);
+
+        // Stop as soon as the game has taken the plan; the next search is already waiting
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping || m_search_state != SEARCH_DONE) return;
+
+        std::copy(m_refine_plan, m_refine_plan + AUTOPILOT_SEGMENTS, m_search.plan);
+    }
+}
+
+void Autopilot::search()
+{
+    Entity* collidables = m_search.collidables.data();
+    int collidable_count = (int)m_search.collidables.size();
+
+    // STEP 1: Fly the current segment forward to where the new plan will take over
+    Entity lander = m_search.lander;
+    Controls controls = m_search.flying;
+    int fuel = m_search.fuel;
+
+    for (int k = 0; k < AUTOPILOT_SEGMENT_STEPS; k++)
+    {
+        if (fuel <= 0) controls.thrust = false;
+
+        apply_controls(&lander, controls, m_gravity);
+        lander.update(m_time_step, collidables, collidable_count);
+        if (controls.thrust) fuel--;
+    }
+
+    // STEP 2: Warm start from the last search, moved on one segment
+    for (int i = 0; i < AUTOPILOT_SEGMENTS - 1; i++)
+    {
+        if (m_search.restart) reset_distribution(i);
+        else
+        {
+            m_thrust_chance[i] = m_thrust_chance[i + 1];
+            for (int j = 0; j < 3; j++) m_turn_chance[i][j] = m_turn_chance[i + 1][j];
+        }
+    }
+    reset_distribution(AUTOPILOT_SEGMENTS - 1);
+
+    // STEP 3: Search
+    replan(m_search.plan, &lander, collidables, collidable_count, m_search.target, fuel);
+
+    // Keep what refine() needs before the game thread can reuse m_search
+    if (m_sustained)
+    {
+        std::copy(m_search.plan, m_search.plan + AUTOPILOT_SEGMENTS, m_refine_plan);
+        m_refine_lander = lander;
+        m_refine_collidables.assign(m_search.collidables.begin(), m_search.collidables.end());
+        m_refine_target = m_search.target;
+        m_refine_fuel = fuel;
+    }
+}
+
+float Autopilot::rollout(const Controls* plan, const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel) const
+{
+    // Entities own no heap memory, so a plain copy is a cheap scratch body
+    Entity body = *lander;
+    int fuel_used = 0;
+
+    for (int i = 0; i < AUTOPILOT_SEGMENTS; i++)
+    {
+        Controls controls = plan[i];
+
+        for (int k = 0; k < AUTOPILOT_SEGMENT_STEPS; k++)
+        {
+            if (fuel_used >= fuel) controls.thrust = false;
+
+            apply_controls(&body, controls, m_gravity);
+            body.update(m_time_step, collidables, collidable_count);
+            if (controls.thrust) fuel_used++;
+
+            if (body.get_cond() == 2) return (float)fuel_used;
+            if (body.get_cond() == 1)
+            {
+                return CRASHED_COST + DISTANCE_WEIGHT * glm::length(body.get_position() - target) + fuel_used;
+            }
+        }
+    }
+
+    // Ran out of horizon: prefer ending close to the goal and slow enough to land
+    float distance = glm::length(body.get_position() - target);
+    float speed = glm::length(body.get_velocity());
+    return MISSED_COST + DISTANCE_WEIGHT * distance + SPEED_WEIGHT * speed + fuel_used;
+}
+
+void Autopilot::evaluate_slice(int slice)
+{
+    int per_thread = (AUTOPILOT_POPULATION + m_thread_count - 1) / m_thread_count;
+    int last = std::min((slice + 1) * per_thread, AUTOPILOT_POPULATION);
+
+    for (int i = slice * per_thread; i < last; i++)
+    {
+        m_costs[i] = rollout(&m_population[i * AUTOPILOT_SEGMENTS], m_batch.lander, m_batch.collidables, m_batch.collidable_count, m_batch.target, m_batch.fuel);
+    }
+}
+
+void Autopilot::work(int slice)
+{
+    int batches_seen = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_batch_ready.wait(lock, [&] { return m_stopping || m_batch_number != batches_seen; });
+            if (m_stopping) return;
+            batches_seen = m_batch_number;
+        }
+
+        evaluate_slice(slice);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_slices_left--;
+        }
+        m_batch_done.notify_one();
+    }
+}
+
+void Autopilot::evaluate(const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel)
+{
+    // Slice the population across the persistent workers; this thread takes the first slice itself
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_batch.lander = lander;
+        m_batch.collidables = collidables;
+        m_batch.collidable_count = collidable_count;
+        m_batch.target = target;
+        m_batch.fuel = fuel;
+        m_slices_left = (int)m_workers.size();
+        m_batch_number++;
+    }
+    m_batch_ready.notify_all();
+
+    evaluate_slice(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_batch_done.wait(lock, [this] { return m_stopping || m_slices_left == 0; });
+}
+
+void Autopilot::replan(Controls* plan, const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    float best_cost = 0.0f;
+
+    for (int iteration = 0; iteration < AUTOPILOT_ITERATIONS; iteration++)
+    {
+        // STEP 1: Sample the population, keeping the current best plan as the first member
+        std::copy(plan, plan + AUTOPILOT_SEGMENTS, m_population.begin());
+
+        for (int p = 1; p < AUTOPILOT_POPULATION; p++)
+        {
+            for (int i = 0; i < AUTOPILOT_SEGMENTS; i++)
+            {
+                Controls& controls = m_population[p * AUTOPILOT_SEGMENTS + i];
+                controls.thrust = chance(m_rng) < m_thrust_chance[i];
+
+                float roll = chance(m_rng);
+                if (roll < m_turn_chance[i][0]) controls.turn = -1;
+                else if (roll < m_turn_chance[i][0] + m_turn_chance[i][1]) controls.turn = 0;
+                else controls.turn = 1;
+            }
+        }
+
+        // STEP 2: Simulate every plan
+        evaluate(lander, collidables, collidable_count, target, fuel);
+
+        // STEP 3: Rank them and keep the best
+        for (int p = 0; p < AUTOPILOT_POPULATION; p++) m_order[p] = p;
+        std::partial_sort(m_order.begin(), m_order.begin() + AUTOPILOT_ELITES, m_order.end(),
+            [&](int a, int b) { return m_costs[a] < m_costs[b]; });
+
+        if (iteration == 0 || m_costs[m_order[0]] < best_cost)
+        {
+            best_cost = m_costs[m_order[0]];
+            std::copy(&m_population[m_order[0] * AUTOPILOT_SEGMENTS], &m_population[m_order[0] * AUTOPILOT_SEGMENTS] + AUTOPILOT_SEGMENTS, plan);
+        }
+
+        // STEP 4: Refit the distribution to the elites
+        for (int i = 0; i < AUTOPILOT_SEGMENTS; i++)
+        {
+            float thrusts = 0.0f;
+            float turns[3] = { 0.0f, 0.0f, 0.0f };
+
+            for (int e = 0; e < AUTOPILOT_ELITES; e++)
+            {
+                const Controls& controls = m_population[m_order[e] * AUTOPILOT_SEGMENTS + i];
+                if (controls.thrust) thrusts += 1.0f;
+                turns[controls.turn + 1] += 1.0f;
+            }
+
+            float thrust_chance = (1.0f - SMOOTHING) * m_thrust_chance[i] + SMOOTHING * thrusts / AUTOPILOT_ELITES;
+            m_thrust_chance[i] = std::min(std::max(thrust_chance, MIN_CHANCE), 1.0f - MIN_CHANCE);
+
+            float total = 0.0f;
+            for (int j = 0; j < 3; j++)
+            {
+                float turn_chance = (1.0f - SMOOTHING) * m_turn_chance[i][j] + SMOOTHING * turns[j] / AUTOPILOT_ELITES;
+                m_turn_chance[i][j] = std::max(turn_chance, MIN_CHANCE);
+                total += m_turn_chance[i][j];
+            }
+            for (int j = 0; j < 3; j++) m_turn_chance[i][j] /= total;
+        }
+    }
+
+    // ————— THROUGHPUT ————— //
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    int rollouts = AUTOPILOT_POPULATION * AUTOPILOT_ITERATIONS;
+
+    m_total_rollouts += rollouts;
+    m_total_seconds = m_total_seconds + seconds;
+    if (seconds > 0.0) m_rollouts_per_second = (float)(rollouts / seconds);
+}
@@ -0,0 +1,160 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// ————— CONTROL MODEL ————— //
+// The same inputs process_input reads from the keyboard
+struct Controls
+{
+    bool thrust = false;
+    int  turn = 0;      // 1 = rotate left, -1 = rotate right, 0 = hold
+};
+
+const float THRUST_ACCELERATION = 1.0f;
+const float TURN_SPEED = 60.0f;     // degrees per second
+
+// Sets the lander's acceleration and spin exactly like a key press would
+void apply_controls(Entity* lander, Controls controls, float gravity);
+
+// ————— PLANNER ————— //
+// Cross-entropy planner: a plan is AUTOPILOT_SEGMENTS control segments, each held for
+// AUTOPILOT_SEGMENT_STEPS fixed timesteps. A search samples AUTOPILOT_POPULATION plans,
+// simulates them with Entity::update on all cores, and refits the sampling distribution
+// to the cheapest AUTOPILOT_ELITES of them.
+//
+// Searches run in the background, one segment ahead: when a segment starts, the planner
+// predicts where the lander will be when it ends and plans from there while the game
+// flies it. The result is swapped in at the next segment boundary, so the game thread
+// never waits on a search; if one is late, the game keeps flying the previous plan.
+const int AUTOPILOT_SEGMENTS = 10;
+const int AUTOPILOT_SEGMENT_STEPS = 15;
+const int AUTOPILOT_POPULATION = 128;
+const int AUTOPILOT_ELITES = 12;
+const int AUTOPILOT_ITERATIONS = 3;
+
+class Autopilot
+{
+private:
+    float m_time_step;
+    float m_gravity;
+    int   m_thread_count;
+
+    // Plan being flown, executed one segment at a time. Only the game thread touches these.
+    Controls m_plan[AUTOPILOT_SEGMENTS];
+    int m_step_in_segment = 0;
+    int m_segment = 0;              // counts segment boundaries, so late results can be recognised
+    bool m_restart = true;          // the next search starts from a fresh distribution
+
+    // ————— SEARCH ————— //
+    // Written by the game thread while the planner is idle, owned by the planner while it searches
+    enum SearchState { SEARCH_IDLE, SEARCH_QUEUED, SEARCH_RUNNING, SEARCH_DONE };
+
+    struct Search
+    {
+        Entity lander;                      // where the segment being flown starts
+        Controls flying;                    // what it flies until the search's plan takes over
+        std::vector<Entity> collidables;    // snapshot, since the world streams while we search
+        glm::vec3 target;
+        int fuel;
+        int segment;                        // the boundary this plan is for
+        bool restart;
+        Controls plan[AUTOPILOT_SEGMENTS];  // warm start in, best plan out
+    };
+
+    Search m_search;
+    SearchState m_search_state = SEARCH_IDLE;
+
+    // Private to the planner: what it keeps refining while a finished plan waits, when sustained
+    Entity m_refine_lander;
+    std::vector<Entity> m_refine_collidables;
+    Controls m_refine_plan[AUTOPILOT_SEGMENTS];
+    glm::vec3 m_refine_target;
+    int m_refine_fuel = 0;
+    std::thread m_planner;
+    std::condition_variable m_search_ready;
+
+    // Sampling distribution: chance of thrusting and of each turn direction per segment.
+    // Only the planner touches these.
+    float m_thrust_chance[AUTOPILOT_SEGMENTS];
+    float m_turn_chance[AUTOPILOT_SEGMENTS][3];
+
+    std::mt19937 m_rng;
+    std::vector<Controls> m_population;    // AUTOPILOT_POPULATION * AUTOPILOT_SEGMENTS
+    std::vector<float> m_costs;
+    std::vector<int> m_order;
+
+    // ————— WORKERS ————— //
+    // Started once and woken per batch, so replanning never creates threads
+    struct Batch
+    {
+        const Entity* lander;
+        Entity* collidables;
+        int collidable_count;
+        glm::vec3 target;
+        int fuel;
+    };
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_batch_ready, m_batch_done;
+    Batch m_batch;
+    int m_batch_number = 0;
+    int m_slices_left = 0;
+    bool m_stopping = false;
+
+    void work(int slice);
+    void evaluate_slice(int slice);
+
+    // ————— THROUGHPUT ————— //
+    // Written by the planner, read by the game thread for the overlay
+    std::atomic<long long> m_total_rollouts{ 0 };
+    std::atomic<double> m_total_seconds{ 0.0 };
+    std::atomic<float> m_rollouts_per_second{ 0.0f };
+
+    float rollout(const Controls* plan, const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel) const;
+    void evaluate(const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel);
+    void begin_segment(const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel);
+    void run_planner();
+    void search();
+    void refine();
+    void replan(Controls* plan, const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel);
+    void reset_distribution(int segment);
+
+public:
+    bool m_is_active = false;
+
+    // Keep the planner searching back-to-back instead of once per segment, so that the
+    // rollouts/sec it reports measures sustained load; --stress turns this on. Set it
+    // before start(), the planner reads it without a lock.
+    bool m_sustained = false;
+
+    Autopilot(float time_step, float gravity);
+    ~Autopilot();
+
+    // Starts the planner and its workers; next_controls() does it too if nobody has.
+    // Call it when the autopilot is switched on, so the threads are never created
+    // for a game that never uses them. Returns whether this call created them.
+    bool start(int collidable_capacity);
+
+    void reset();
+    Controls next_controls(const Entity* lander, Entity* collidables, int collidable_count, glm::vec3 target, int fuel);
+
+    // ————— GETTERS ————— //
+    float const get_rollouts_per_second() const { return m_rollouts_per_second; };
+    long long const get_total_rollouts() const { return m_total_rollouts; };
+    float const get_average_rollouts_per_second() const { double seconds = m_total_seconds; return seconds > 0.0 ? (float)(m_total_rollouts / seconds) : 0.0f; };
+    int const get_thread_count() const { return m_thread_count; };
+};
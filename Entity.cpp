@@ -52,11 +52,6 @@ Entity::Entity(EntityType type, bool active)
     m_is_active = active;
 }
 
-Entity::~Entity()
-{
-    delete[] m_animation_on;
-}
-
 bool const Entity::check_collision(Entity* other) const
 {
     if (!m_is_active || !other->m_is_active) return false;
@@ -67,6 +62,15 @@ bool const Entity::check_collision(Entity* other) const
     return x_distance < 0.0f && y_distance < 0.0f;
 }
 
+bool const Entity::in_view(glm::vec3 view_min, glm::vec3 view_max) const
+{
+    // Radius of the circle around the scaled quad, whatever its rotation
+    float radius = 0.7072f * fmax(fabs(m_scale.x), fabs(m_scale.y));
+
+    return m_position.x + radius >= view_min.x && m_position.x - radius <= view_max.x &&
+        m_position.y + radius >= view_min.y && m_position.y - radius <= view_max.y;
+}
+
 void Entity::draw_sprite_from_texture_atlas(ShaderProgram* program, GLuint texture_id, int index)
 {
     // Step 1: Calculate the UV location of the indexed frame
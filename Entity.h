@@ -9,18 +9,26 @@
 **/
 
 enum EntityType { S_PLATFORM, PLATFORM, V_PLATFORM, PLAYER, SCREEN, FIRE, BG };
+const int ENTITY_TYPE_COUNT = BG + 1;
+
+// Frame indices for one animation, kept in a Pool so entities never own heap memory
+const int MAX_ANIMATION_FRAMES = 16;
+
+struct AnimationFrames
+{
+    int indices[MAX_ANIMATION_FRAMES];
+};
 
 class Entity
 {
 private:
-    int* m_animation_on = NULL;
-
     glm::vec3 m_position;
     glm::vec3 m_velocity;
     glm::vec3 m_acceleration;
     glm::vec3 m_scale;
     float m_angle_speed;
     float m_angle;
+    float m_mass = 1.0f;
     
 
     float m_width = 1.0f,
@@ -39,6 +47,7 @@ public:
     bool const check_collision(Entity* other) const;
     void const check_collision_x(Entity* collidable_entities, int collidable_entity_count);
     void const check_collision_y(Entity* collidable_entities, int collidable_entity_count);
+    bool const in_view(glm::vec3 view_min, glm::vec3 view_max) const;
 
     // ————— STATIC VARIABLES ————— //
     static const int SECONDS_PER_FRAME = 4;
@@ -50,7 +59,7 @@ public:
         m_animation_cols = 0,
         m_animation_rows = 0;
 
-    int* m_animation_indices = NULL;
+    int* m_animation_indices = NULL;      // points into a pooled AnimationFrames, not owned
     float m_animation_time = 0.0f;
 
     // ————— TRANSFORMATIONS ————— //
@@ -63,7 +72,6 @@ public:
     // ————— METHODS ————— //
     Entity();
     Entity(EntityType type, bool active);
-    ~Entity();
 
     void draw_sprite_from_texture_atlas(ShaderProgram* program, GLuint texture_id, int index);
     void update(float delta_time, Entity* collidable_entities, int entity_count);
@@ -77,6 +85,7 @@ public:
     glm::vec3 const get_movement()     const { return m_movement; };
     float const get_angle_speed()   const { return m_angle_speed; };
     float const get_angle()            const { return m_angle; };
+    float const get_mass()             const { return m_mass; };
     EntityType const get_type()     const { return m_type; };
     int const get_cond()           const { return m_condition; };
 
@@ -87,8 +96,10 @@ public:
     void const set_movement(glm::vec3 new_movement) { m_movement = new_movement; };
     void const set_angle_speed(float new_angle_sp) { m_angle_speed = new_angle_sp; };
     void const set_angle(float new_angle) { m_angle = new_angle; };
+    void const set_mass(float new_mass) { m_mass = new_mass; };
     void const set_scale(glm::vec3 new_scale, float new_height, float new_width) { m_scale = new_scale; m_height = new_height; m_width = new_width; };
     void const set_type(EntityType new_type, bool active) { m_type = new_type; m_is_active = active; };
     void const set_wh(float new_w, float new_h) { m_width = new_w; m_height = new_h; };
+    void const set_cond(int new_cond) { m_condition = new_cond; };
 
 };
\ No newline at end of file
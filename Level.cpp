@@ -0,0 +1,200 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#ifdef _WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Level.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+Level::~Level()
+{
+    close();
+}
+
+bool Level::open(const char* filepath)
+{
+    close();
+
+#ifdef _WINDOWS
+    m_file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        m_file = NULL;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(m_file, &size);
+    m_size = (size_t)size.QuadPart;
+
+    m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_mapping != NULL) m_data = (const unsigned char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    int file = ::open(filepath, O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat info;
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+    {
+        m_size = (size_t)info.st_size;
+        void* data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED) m_data = (const unsigned char*)data;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(file);
+#endif
+
+    if (m_data == NULL || !validate())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void Level::close()
+{
+#ifdef _WINDOWS
+    if (m_data != NULL) UnmapViewOfFile(m_data);
+    if (m_mapping != NULL) CloseHandle(m_mapping);
+    if (m_file != NULL) CloseHandle(m_file);
+    m_mapping = NULL;
+    m_file = NULL;
+#else
+    if (m_data != NULL) munmap((void*)m_data, m_size);
+#endif
+
+    m_data = NULL;
+    m_size = 0;
+}
+
+bool Level::validate() const
+{
+    if (m_size < sizeof(LevelHeader)) return false;
+
+    const LevelHeader* header = get_header();
+    if (memcmp(header->magic, LEVEL_MAGIC, sizeof(LEVEL_MAGIC)) != 0) return false;
+    if (header->version != LEVEL_VERSION) return false;
+    if (!(header->chunk_size > 0.0f)) return false;
+    if (header->field_texture >= (int32_t)header->texture_count) return false;
+    if (header->field_max_per_chunk > 0 && !(header->field_min_size > 0.0f && header->field_max_size <= header->chunk_size)) return false;
+
+    // Every table has to fit inside the file
+    uint64_t chunk_count = (uint64_t)header->chunk_cols * header->chunk_rows;
+    if (header->texture_offset + (uint64_t)header->texture_count * LEVEL_TEXTURE_PATH_SIZE > m_size) return false;
+    if (header->chunk_offset + chunk_count * sizeof(LevelChunk) > m_size) return false;
+    if (header->entity_offset + (uint64_t)header->entity_count * sizeof(LevelEntity) > m_size) return false;
+    if (header->chunk_offset % alignof(LevelChunk) != 0 || header->entity_offset % alignof(LevelEntity) != 0) return false;
+
+    // Only the index is checked up front; entity pages are not touched until their chunk streams in
+    const LevelChunk* chunks = (const LevelChunk*)(m_data + header->chunk_offset);
+    for (uint64_t i = 0; i < chunk_count; i++)
+    {
+        if ((uint64_t)chunks[i].first_entity + chunks[i].entity_count > header->entity_count) return false;
+    }
+
+    for (uint32_t i = 0; i < header->texture_count; i++)
+    {
+        if (memchr(get_texture_path(i), '\0', LEVEL_TEXTURE_PATH_SIZE) == NULL) return false;
+    }
+
+    return true;
+}
+
+const LevelChunk* Level::get_chunk(int chunk_x, int chunk_y) const
+{
+    const LevelHeader* header = get_header();
+
+    int column = chunk_x - header->chunk_min_x;
+    int row = chunk_y - header->chunk_min_y;
+    if (column < 0 || row < 0 || column >= (int)header->chunk_cols || row >= (int)header->chunk_rows) return NULL;
+
+    const LevelChunk* chunks = (const LevelChunk*)(m_data + header->chunk_offset);
+    return &chunks[row * header->chunk_cols + column];
+}
+
+bool Level::write(const char* filepath, LevelHeader header, const std::vector<std::string>& textures, std::vector<LevelEntity> entities)
+{
+    memcpy(header.magic, LEVEL_MAGIC, sizeof(LEVEL_MAGIC));
+    header.version = LEVEL_VERSION;
+    header.texture_count = (uint32_t)textures.size();
+    header.entity_count = (uint32_t)entities.size();
+
+    float chunk_size = header.chunk_size;
+
+    // STEP 1: Find the chunk grid that covers every entity
+    auto chunk_of = [&](float position) { return (int)std::floor(position / chunk_size); };
+
+    int min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+    for (size_t i = 0; i < entities.size(); i++)
+    {
+        int x = chunk_of(entities[i].x);
+        int y = chunk_of(entities[i].y);
+        min_x = i == 0 ? x : std::min(min_x, x);
+        min_y = i == 0 ? y : std::min(min_y, y);
+        max_x = i == 0 ? x : std::max(max_x, x);
+        max_y = i == 0 ? y : std::max(max_y, y);
+    }
+
+    header.chunk_min_x = min_x;
+    header.chunk_min_y = min_y;
+    header.chunk_cols = (uint32_t)(max_x - min_x + 1);
+    header.chunk_rows = (uint32_t)(max_y - min_y + 1);
+
+    // STEP 2: Sort entities so each chunk is one contiguous run
+    auto chunk_index = [&](const LevelEntity& entity)
+    {
+        return (uint32_t)(chunk_of(entity.y) - min_y) * header.chunk_cols + (uint32_t)(chunk_of(entity.x) - min_x);
+    };
+    std::stable_sort(entities.begin(), entities.end(),
+        [&](const LevelEntity& a, const LevelEntity& b) { return chunk_index(a) < chunk_index(b); });
+
+    std::vector<LevelChunk> chunks(header.chunk_cols * header.chunk_rows, LevelChunk{ 0, 0 });
+    for (size_t i = entities.size(); i-- > 0;)
+    {
+        LevelChunk& chunk = chunks[chunk_index(entities[i])];
+        chunk.first_entity = (uint32_t)i;
+        chunk.entity_count++;
+    }
+
+    // STEP 3: Lay the tables out one after another
+    header.texture_offset = sizeof(LevelHeader);
+    header.chunk_offset = header.texture_offset + header.texture_count * LEVEL_TEXTURE_PATH_SIZE;
+    header.entity_offset = header.chunk_offset + (uint32_t)(chunks.size() * sizeof(LevelChunk));
+
+    FILE* file = fopen(filepath, "wb");
+    if (file == NULL) return false;
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for (size_t i = 0; i < textures.size() && written; i++)
+    {
+        char path[LEVEL_TEXTURE_PATH_SIZE] = {};
+        strncpy(path, textures[i].c_str(), LEVEL_TEXTURE_PATH_SIZE - 1);
+        written = fwrite(path, sizeof(path), 1, file) == 1;
+    }
+
+    if (written && !chunks.empty()) written = fwrite(chunks.data(), sizeof(LevelChunk), chunks.size(), file) == chunks.size();
+    if (written && !entities.empty()) written = fwrite(entities.data(), sizeof(LevelEntity), entities.size(), file) == entities.size();
+
+    return fclose(file) == 0 && written;
+}
@@ -0,0 +1,106 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// ————— FILE FORMAT ————— //
+// A level file is laid out as:
+//   LevelHeader
+//   texture_count  x char[LEVEL_TEXTURE_PATH_SIZE]   (texture table)
+//   chunk_cols * chunk_rows x LevelChunk            (spatial chunk index, row-major)
+//   entity_count   x LevelEntity                    (sorted by chunk)
+// Entities belong to the chunk containing their centre, so each chunk is one
+// contiguous run of records that can be read straight out of the mapping.
+const char LEVEL_MAGIC[4] = { 'L', 'V', 'L', 'S' };
+const uint32_t LEVEL_VERSION = 2;
+const int LEVEL_TEXTURE_PATH_SIZE = 64;
+
+struct LevelHeader
+{
+    char     magic[4];
+    uint32_t version;
+
+    float    chunk_size;
+    int32_t  chunk_min_x, chunk_min_y;      // chunk coordinates of the first column and row
+    uint32_t chunk_cols, chunk_rows;
+
+    uint32_t texture_count;
+    uint32_t entity_count;
+
+    float    player_start_x, player_start_y;
+    float    goal_x, goal_y;
+    float    bounds_min_x, bounds_min_y;    // area the camera is allowed to show
+    float    bounds_max_x, bounds_max_y;
+
+    // Procedural asteroid field generated per chunk on top of the stored entities
+    uint32_t field_seed;
+    int32_t  field_texture;                 // texture table index, -1 for no field
+    uint32_t field_max_per_chunk;
+    float    field_min_size, field_max_size;
+    float    field_clearance;               // free space kept around stored entities, the start and the goal
+
+    uint32_t texture_offset;
+    uint32_t chunk_offset;
+    uint32_t entity_offset;
+};
+
+struct LevelChunk
+{
+    uint32_t first_entity;
+    uint32_t entity_count;
+};
+
+struct LevelEntity
+{
+    int32_t type;       // EntityType
+    int32_t texture;    // index into the texture table
+    float   x, y;
+    float   width, height;
+    float   scale_x, scale_y;
+    float   angle;
+};
+
+class Level
+{
+private:
+    const unsigned char* m_data = NULL;
+    size_t m_size = 0;
+
+#ifdef _WINDOWS
+    void* m_file = NULL;
+    void* m_mapping = NULL;
+#endif
+
+    bool validate() const;
+
+public:
+    ~Level();
+
+    bool open(const char* filepath);
+    void close();
+
+    // Chunk coordinates are world coordinates divided by chunk_size, rounded down
+    const LevelChunk* get_chunk(int chunk_x, int chunk_y) const;
+
+    // ————— GETTERS ————— //
+    bool const is_open() const { return m_data != NULL; };
+    size_t const get_mapped_bytes() const { return m_size; };
+    const LevelHeader* get_header() const { return (const LevelHeader*)m_data; };
+    const char* get_texture_path(int index) const { return (const char*)(m_data + get_header()->texture_offset) + index * LEVEL_TEXTURE_PATH_SIZE; };
+    const LevelEntity* get_entities() const { return (const LevelEntity*)(m_data + get_header()->entity_offset); };
+
+    // Sorts the entities into chunks and writes a complete level file. The header supplies the
+    // chunk size, start, goal, bounds and field settings; the tables and offsets are filled in.
+    // Entities should be no larger than one chunk so neighbouring chunks cover their overlap
+    static bool write(const char* filepath, LevelHeader header, const std::vector<std::string>& textures, std::vector<LevelEntity> entities);
+};
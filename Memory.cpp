@@ -0,0 +1,187 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#include "Memory.h"
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// ————— ALLOCATION COUNTER ————— //
+static thread_local long long t_allocation_count = 0;
+static thread_local MemorySubsystem t_subsystem = MEMORY_OTHER;
+
+static std::atomic<long long> s_heap_bytes[MEMORY_SUBSYSTEM_COUNT];
+static std::atomic<long long> s_heap_peak_bytes[MEMORY_SUBSYSTEM_COUNT];
+static std::atomic<long long> s_heap_allocations[MEMORY_SUBSYSTEM_COUNT];
+
+const char* const MEMORY_SUBSYSTEM_NAMES[MEMORY_SUBSYSTEM_COUNT] = { "OTHER", "ENTITIES", "TEXT", "ASSETS", "WORLD", "PLANNER" };
+
+// Each block starts with a header recording who paid for it, padded so the
+// memory handed out keeps malloc's alignment
+struct AllocationHeader
+{
+    size_t size;
+    MemorySubsystem subsystem;
+};
+
+const size_t HEADER_SIZE = (sizeof(AllocationHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+long long thread_allocation_count()
+{
+    return t_allocation_count;
+}
+
+MemoryScope::MemoryScope(MemorySubsystem subsystem)
+{
+    m_previous = t_subsystem;
+    t_subsystem = subsystem;
+}
+
+MemoryScope::~MemoryScope()
+{
+    t_subsystem = m_previous;
+}
+
+long long heap_bytes(MemorySubsystem subsystem) { return s_heap_bytes[subsystem].load(); }
+long long heap_peak_bytes(MemorySubsystem subsystem) { return s_heap_peak_bytes[subsystem].load(); }
+long long heap_allocations(MemorySubsystem subsystem) { return s_heap_allocations[subsystem].load(); }
+
+void* heap_allocate(size_t size)
+{
+    AllocationHeader* header = (AllocationHeader*)malloc(HEADER_SIZE + size);
+    if (header == NULL) return NULL;
+
+    t_allocation_count++;
+    header->size = size;
+    header->subsystem = t_subsystem;
+
+    long long bytes = s_heap_bytes[t_subsystem].fetch_add((long long)size) + (long long)size;
+    s_heap_allocations[t_subsystem]++;
+
+    long long peak = s_heap_peak_bytes[t_subsystem].load();
+    while (bytes > peak && !s_heap_peak_bytes[t_subsystem].compare_exchange_weak(peak, bytes)) {}
+
+    return (unsigned char*)header + HEADER_SIZE;
+}
+
+void heap_free(void* memory)
+{
+    if (memory == NULL) return;
+
+    AllocationHeader* header = (AllocationHeader*)((unsigned char*)memory - HEADER_SIZE);
+    s_heap_bytes[header->subsystem] -= (long long)header->size;
+    s_heap_allocations[header->subsystem]--;
+
+    free(header);
+}
+
+void* heap_reallocate(void* memory, size_t size)
+{
+    if (memory == NULL) return heap_allocate(size);
+
+    // The block stays charged to whoever allocated it; only its size changes
+    AllocationHeader* header = (AllocationHeader*)((unsigned char*)memory - HEADER_SIZE);
+    MemorySubsystem subsystem = header->subsystem;
+    size_t old_size = header->size;
+
+    header = (AllocationHeader*)realloc(header, HEADER_SIZE + size);
+    if (header == NULL) return NULL;
+
+    t_allocation_count++;
+    header->size = size;
+
+    long long bytes = s_heap_bytes[subsystem].fetch_add((long long)size - (long long)old_size) + (long long)size - (long long)old_size;
+    long long peak = s_heap_peak_bytes[subsystem].load();
+    while (bytes > peak && !s_heap_peak_bytes[subsystem].compare_exchange_weak(peak, bytes)) {}
+
+    return (unsigned char*)header + HEADER_SIZE;
+}
+
+void* operator new(size_t size)
+{
+    void* memory = heap_allocate(size);
+    if (memory == NULL) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    void* memory = heap_allocate(size);
+    if (memory == NULL) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return heap_allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return heap_allocate(size); }
+
+void operator delete(void* memory) noexcept { heap_free(memory); }
+void operator delete[](void* memory) noexcept { heap_free(memory); }
+void operator delete(void* memory, size_t) noexcept { heap_free(memory); }
+void operator delete[](void* memory, size_t) noexcept { heap_free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { heap_free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { heap_free(memory); }
+
+// ————— FRAME ARENA ————— //
+Arena::~Arena()
+{
+    release();
+}
+
+void Arena::init(size_t capacity)
+{
+    delete[] m_buffer;
+
+    m_buffer = new unsigned char[capacity];
+    m_capacity = capacity;
+    m_used = 0;
+    m_peak = 0;
+}
+
+void Arena::release()
+{
+    delete[] m_buffer;
+    m_buffer = NULL;
+    m_capacity = m_used = 0;
+}
+
+void* Arena::allocate(size_t bytes, size_t alignment)
+{
+    size_t start = (m_used + alignment - 1) & ~(alignment - 1);
+    if (start + bytes > m_capacity) return NULL;
+
+    m_used = start + bytes;
+    if (m_used > m_peak) m_peak = m_used;
+
+    return m_buffer + start;
+}
+
+const char* Arena::format(const char* format, ...)
+{
+    va_list arguments;
+
+    // STEP 1: Measure, so we take exactly what the text needs
+    va_start(arguments, format);
+    int length = vsnprintf(NULL, 0, format, arguments);
+    va_end(arguments);
+    if (length < 0) return "";
+
+    char* text = allocate_array<char>((size_t)length + 1);
+    if (text == NULL) return "";
+
+    // STEP 2: Print into the arena
+    va_start(arguments, format);
+    vsnprintf(text, (size_t)length + 1, format, arguments);
+    va_end(arguments);
+
+    return text;
+}
@@ -0,0 +1,84 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#include <cstddef>
+
+// ————— ALLOCATION COUNTER ————— //
+// Memory.cpp replaces the global operator new/delete to count heap allocations
+// made by the calling thread, so the game loop can check a frame made none.
+long long thread_allocation_count();
+
+// ————— HEAP ACCOUNTING ————— //
+// Every allocation is charged to the subsystem that is current on the allocating
+// thread, and credited back to the same subsystem when it is freed, wherever that is.
+enum MemorySubsystem { MEMORY_OTHER, MEMORY_ENTITIES, MEMORY_TEXT, MEMORY_ASSETS, MEMORY_WORLD, MEMORY_PLANNER, MEMORY_SUBSYSTEM_COUNT };
+
+extern const char* const MEMORY_SUBSYSTEM_NAMES[MEMORY_SUBSYSTEM_COUNT];
+
+// Makes a subsystem current for the rest of the enclosing block
+class MemoryScope
+{
+private:
+    MemorySubsystem m_previous;
+
+public:
+    MemoryScope(MemorySubsystem subsystem);
+    ~MemoryScope();
+};
+
+long long heap_bytes(MemorySubsystem subsystem);
+long long heap_peak_bytes(MemorySubsystem subsystem);
+long long heap_allocations(MemorySubsystem subsystem);      // currently live
+
+// malloc/realloc/free with the same accounting, for C libraries that let us plug
+// in an allocator (stb_image's decoded pixels are charged this way)
+void* heap_allocate(size_t size);
+void* heap_reallocate(void* memory, size_t size);
+void heap_free(void* memory);
+
+// Empties a standard container and gives its memory back. clear() keeps the capacity,
+// which is what we want between frames but would show up as held memory at exit.
+template <typename Container>
+void release_container(Container& container) { Container().swap(container); };
+
+// ————— FRAME ARENA ————— //
+// Bump allocator for data that only lives until the end of the frame. The buffer
+// is allocated once; reset() at the start of every frame makes it all reusable.
+class Arena
+{
+private:
+    unsigned char* m_buffer = NULL;
+    size_t m_capacity = 0;
+    size_t m_used = 0;
+    size_t m_peak = 0;
+
+public:
+    Arena() {}
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+
+    void init(size_t capacity);
+    void release();
+    void reset() { m_used = 0; };
+
+    // Returns NULL when the arena is out of space
+    void* allocate(size_t bytes, size_t alignment);
+    template <typename T>
+    T* allocate_array(size_t count) { return (T*)allocate(sizeof(T) * count, alignof(T)); };
+
+    // printf into the arena, for text that is drawn this frame
+    const char* format(const char* format, ...);
+
+    // ————— GETTERS ————— //
+    size_t const get_capacity() const { return m_capacity; };
+    size_t const get_used() const { return m_used; };
+    size_t const get_peak() const { return m_peak; };
+};
@@ -0,0 +1,135 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#include <cstdint>
+
+// Refers to a pool slot. The generation changes every time the slot is released,
+// so a handle to something that has been despawned simply stops resolving.
+struct Handle
+{
+    uint32_t index = 0;
+    uint32_t generation = 0;    // 0 is never live, so a default Handle is null
+};
+
+// Fixed-capacity pool of T. All storage is allocated once in init(), so spawning and
+// despawning never touch the heap. Live items are kept packed at the front of one array,
+// which lets Entity pools hand data() and get_live_count() straight to Entity::update as
+// the collidable list. Releasing moves the last live item into the gap, so a raw pointer
+// only stays valid until the next release; Handles find items wherever they move to.
+template <typename T>
+class Pool
+{
+private:
+    T*        m_items = NULL;
+    uint32_t* m_generations = NULL;     // per slot
+    int*      m_next_free = NULL;       // per slot
+    int*      m_item_of_slot = NULL;
+    int*      m_slot_of_item = NULL;
+    int m_capacity = 0;
+    int m_live_count = 0;
+    int m_free_head = -1;
+
+public:
+    Pool() {}
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+    ~Pool() { release_storage(); }
+
+    void init(int capacity)
+    {
+        release_storage();
+
+        m_items = new T[capacity];
+        m_generations = new uint32_t[capacity];
+        m_next_free = new int[capacity];
+        m_item_of_slot = new int[capacity];
+        m_slot_of_item = new int[capacity];
+        m_capacity = capacity;
+
+        // Generations start odd when live and even when free
+        for (int i = 0; i < capacity; i++)
+        {
+            m_generations[i] = 0;
+            m_next_free[i] = i + 1 < capacity ? i + 1 : -1;
+        }
+        m_free_head = capacity > 0 ? 0 : -1;
+        m_live_count = 0;
+    }
+
+    void release_storage()
+    {
+        delete[] m_items;
+        delete[] m_generations;
+        delete[] m_next_free;
+        delete[] m_item_of_slot;
+        delete[] m_slot_of_item;
+        m_items = NULL;
+        m_generations = NULL;
+        m_next_free = NULL;
+        m_item_of_slot = NULL;
+        m_slot_of_item = NULL;
+        m_capacity = m_live_count = 0;
+        m_free_head = -1;
+    }
+
+    // Returns a null handle when the pool is full
+    Handle allocate()
+    {
+        Handle handle;
+        if (m_free_head < 0) return handle;
+
+        int slot = m_free_head;
+        m_free_head = m_next_free[slot];
+
+        int item = m_live_count++;
+        m_items[item] = T();
+        m_item_of_slot[slot] = item;
+        m_slot_of_item[item] = slot;
+        m_generations[slot]++;
+
+        handle.index = (uint32_t)slot;
+        handle.generation = m_generations[slot];
+        return handle;
+    }
+
+    void release(Handle handle)
+    {
+        if (get(handle) == NULL) return;
+
+        // Fill the gap with the last live item
+        int item = m_item_of_slot[handle.index];
+        int last = --m_live_count;
+        if (item != last)
+        {
+            m_items[item] = m_items[last];
+            m_slot_of_item[item] = m_slot_of_item[last];
+            m_item_of_slot[m_slot_of_item[item]] = item;
+        }
+
+        m_generations[handle.index]++;
+        m_next_free[handle.index] = m_free_head;
+        m_free_head = (int)handle.index;
+    }
+
+    T* get(Handle handle) const
+    {
+        if (handle.index >= (uint32_t)m_capacity || handle.generation == 0 || m_generations[handle.index] != handle.generation) return NULL;
+        return &m_items[m_item_of_slot[handle.index]];
+    }
+
+    // Handle of the live item at data()[item]
+    Handle get_handle(int item) const { Handle handle; handle.index = (uint32_t)m_slot_of_item[item]; handle.generation = m_generations[handle.index]; return handle; };
+    Handle get_handle(const T* item) const { return get_handle((int)(item - m_items)); };
+
+    // ————— GETTERS ————— //
+    T* data() const { return m_items; };
+    int const get_capacity() const { return m_capacity; };
+    int const get_live_count() const { return m_live_count; };
+};
@@ -0,0 +1,139 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#define GL_SILENCE_DEPRECATION
+
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL.h>
+#include <SDL_opengl.h>
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "ShaderProgram.h"
+#include "Entity.h"
+#include "Memory.h"
+#include "Pool.h"
+#include "Resources.h"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// RGBA8 with no mipmaps, which is all load_texture uploads
+const int BYTES_PER_TEXEL = 4;
+
+const char* const ENTITY_TYPE_NAMES[ENTITY_TYPE_COUNT] = { "S_PLATFORM", "PLATFORM", "V_PLATFORM", "PLAYER", "SCREEN", "FIRE", "BG" };
+
+static std::vector<TrackedResource> s_textures;
+static std::vector<TrackedResource> s_buffers;
+
+static void track(std::vector<TrackedResource>& resources, GLuint id, int width, int height, long long bytes, const char* name)
+{
+    // The bookkeeping itself is not charged to whoever happens to be loading
+    MemoryScope scope(MEMORY_OTHER);
+
+    TrackedResource resource;
+    resource.id = id;
+    resource.width = width;
+    resource.height = height;
+    resource.bytes = bytes;
+    strncpy(resource.name, name, RESOURCE_NAME_SIZE - 1);
+    resource.name[RESOURCE_NAME_SIZE - 1] = '\0';
+
+    resources.push_back(resource);
+}
+
+static void untrack(std::vector<TrackedResource>& resources, GLuint id)
+{
+    for (size_t i = 0; i < resources.size(); i++)
+    {
+        if (resources[i].id != id) continue;
+
+        resources[i] = resources.back();
+        resources.pop_back();
+        return;
+    }
+}
+
+static long long total_bytes(const std::vector<TrackedResource>& resources)
+{
+    long long bytes = 0;
+    for (const TrackedResource& resource : resources) bytes += resource.bytes;
+    return bytes;
+}
+
+void track_texture(GLuint id, int width, int height, const char* name) { track(s_textures, id, width, height, (long long)width * height * BYTES_PER_TEXEL, name); }
+void untrack_texture(GLuint id) { untrack(s_textures, id); }
+void track_buffer(GLuint id, long long bytes, const char* name) { track(s_buffers, id, 0, 0, bytes, name); }
+void untrack_buffer(GLuint id) { untrack(s_buffers, id); }
+
+int tracked_texture_count() { return (int)s_textures.size(); }
+long long tracked_texture_bytes() { return total_bytes(s_textures); }
+int tracked_buffer_count() { return (int)s_buffers.size(); }
+long long tracked_buffer_bytes() { return total_bytes(s_buffers); }
+
+void count_live_entities(const Pool<Entity>& pool, int counts[ENTITY_TYPE_COUNT])
+{
+    for (int i = 0; i < pool.get_live_count(); i++)
+    {
+        int type = pool.data()[i].get_type();
+        if (type >= 0 && type < ENTITY_TYPE_COUNT) counts[type]++;
+    }
+}
+
+int print_resource_report(const int entity_counts[ENTITY_TYPE_COUNT], bool at_exit)
+{
+    int leaks = 0;
+
+    // STEP 1: CPU heap by subsystem
+    std::cout << "———— HEAP ————\n";
+    for (int i = 0; i < MEMORY_SUBSYSTEM_COUNT; i++)
+    {
+        MemorySubsystem subsystem = (MemorySubsystem)i;
+        bool leaked = at_exit && subsystem != MEMORY_OTHER && subsystem != MEMORY_PLANNER && heap_bytes(subsystem) != 0;
+        if (leaked) leaks++;
+
+        std::cout << MEMORY_SUBSYSTEM_NAMES[i] << ": " << heap_bytes(subsystem) << " bytes in " << heap_allocations(subsystem)
+            << " allocations, peak " << heap_peak_bytes(subsystem) << " bytes" << (leaked ? "  <- LEAK" : "") << '\n';
+    }
+
+    // STEP 2: GL resources, listed one by one since at exit every one of them is a leak
+    std::cout << "———— GL ————\n";
+    std::cout << "Textures: " << s_textures.size() << ", " << total_bytes(s_textures) << " bytes of VRAM (estimated)\n";
+    for (const TrackedResource& texture : s_textures)
+    {
+        std::cout << "  " << texture.name << " " << texture.width << "x" << texture.height << ", " << texture.bytes << " bytes" << (at_exit ? "  <- LEAK" : "") << '\n';
+    }
+
+    std::cout << "Buffers: " << s_buffers.size() << ", " << total_bytes(s_buffers) << " bytes of VRAM (estimated)\n";
+    for (const TrackedResource& buffer : s_buffers)
+    {
+        std::cout << "  " << buffer.name << ", " << buffer.bytes << " bytes" << (at_exit ? "  <- LEAK" : "") << '\n';
+    }
+
+    if (at_exit) leaks += (int)(s_textures.size() + s_buffers.size());
+
+    // STEP 3: Live entities
+    std::cout << "———— ENTITIES ————\n";
+    for (int i = 0; i < ENTITY_TYPE_COUNT; i++)
+    {
+        bool leaked = at_exit && entity_counts[i] != 0;
+        if (leaked) leaks++;
+
+        std::cout << ENTITY_TYPE_NAMES[i] << ": " << entity_counts[i] << (leaked ? "  <- LEAK" : "") << '\n';
+    }
+
+    if (at_exit && leaks == 0) std::cout << "No leaks\n";
+    if (at_exit && leaks != 0) std::cout << leaks << " leaks found\n";
+
+    return leaks;
+}
@@ -0,0 +1,47 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+// ————— GL RESOURCES ————— //
+// Whoever creates a texture or buffer reports it here, and reports it again when
+// it is deleted, so anything still listed at exit has leaked. VRAM is estimated
+// from the size we uploaded, since GL has no portable way to ask.
+const int RESOURCE_NAME_SIZE = 64;
+
+struct TrackedResource
+{
+    GLuint id;
+    int width, height;          // 0 for buffers
+    long long bytes;
+    char name[RESOURCE_NAME_SIZE];
+};
+
+void track_texture(GLuint id, int width, int height, const char* name);
+void untrack_texture(GLuint id);
+void track_buffer(GLuint id, long long bytes, const char* name);
+void untrack_buffer(GLuint id);
+
+int tracked_texture_count();
+long long tracked_texture_bytes();
+int tracked_buffer_count();
+long long tracked_buffer_bytes();
+
+// ————— ENTITIES ————— //
+extern const char* const ENTITY_TYPE_NAMES[ENTITY_TYPE_COUNT];
+
+// Adds the live entities of a pool to counts, by EntityType. For the exit report, count
+// after despawning but before releasing the pool's storage, or nothing is ever found.
+void count_live_entities(const Pool<Entity>& pool, int counts[ENTITY_TYPE_COUNT]);
+
+// ————— REPORT ————— //
+// Prints heap use per subsystem, every tracked GL resource and the entity counts.
+// At exit anything the game owns should be gone; whatever is left is reported as a
+// leak. OTHER and PLANNER are exempt, as they hold library and static-lifetime memory.
+// Returns the number of leaks found.
+int print_resource_report(const int entity_counts[ENTITY_TYPE_COUNT], bool at_exit);
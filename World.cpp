@@ -0,0 +1,397 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#define GL_SILENCE_DEPRECATION
+
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL.h>
+#include <SDL_opengl.h>
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "ShaderProgram.h"
+#include "Entity.h"
+#include "Level.h"
+#include "Memory.h"
+#include "Pool.h"
+#include "AsteroidField.h"
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+static int64_t tile_key(int chunk_x, int chunk_y)
+{
+    return (int64_t)(((uint64_t)(uint32_t)chunk_x << 32) | (uint32_t)chunk_y);
+}
+
+static int key_x(int64_t key) { return (int)(uint32_t)((uint64_t)key >> 32); }
+static int key_y(int64_t key) { return (int)(uint32_t)key; }
+
+bool World::open(const char* filepath, GLuint (*load_texture)(const char*))
+{
+    MemoryScope scope(MEMORY_WORLD);
+
+    if (!m_level.open(filepath)) return false;
+
+    const LevelHeader* header = m_level.get_header();
+
+    // The texture table is tiny, so resolve it once instead of per chunk
+    m_textures.clear();
+    for (uint32_t i = 0; i < header->texture_count; i++)
+    {
+        m_textures.push_back(load_texture(m_level.get_texture_path(i)));
+    }
+
+    // The pool is sized on the first stream(), once we know how big the view is
+    m_entities.release_storage();
+    m_entity_chunks.clear();
+    m_sized = false;
+    m_has_window = false;
+    m_chunk_count = 0;
+
+    m_max_per_chunk = 0;
+    for (int y = header->chunk_min_y; y < header->chunk_min_y + (int)header->chunk_rows; y++)
+    {
+        for (int x = header->chunk_min_x; x < header->chunk_min_x + (int)header->chunk_cols; x++)
+        {
+            m_max_per_chunk = std::max(m_max_per_chunk, (int)m_level.get_chunk(x, y)->entity_count);
+        }
+    }
+    m_max_stored_per_chunk = m_max_per_chunk;
+
+    // ————— ASTEROID FIELD ————— //
+    // The worker starts with the first stream(), once the tiles it works on exist
+    m_field.stop();
+    m_pending.clear();
+    m_tiles.clear();
+    m_free_tiles.clear();
+    m_has_field = header->field_texture >= 0 && header->field_max_per_chunk > 0;
+
+    if (m_has_field)
+    {
+        m_field_settings.seed = header->field_seed;
+        m_field_settings.tile_size = header->chunk_size;
+        m_field_settings.max_per_tile = (int)header->field_max_per_chunk;
+        m_field_settings.min_size = header->field_min_size;
+        m_field_settings.max_size = header->field_max_size;
+        m_field_texture = m_textures[header->field_texture];
+        m_max_per_chunk += m_field_settings.max_per_tile;
+    }
+
+    return true;
+}
+
+void World::close(void (*unload_texture)(GLuint))
+{
+    m_field.stop();
+    m_has_field = false;
+
+    for (GLuint texture_id : m_textures) unload_texture(texture_id);
+
+    while (m_entities.get_live_count() > 0) m_entities.release(m_entities.get_handle(m_entities.get_live_count() - 1));
+
+    release_container(m_textures);
+    release_container(m_pending);
+    release_container(m_tiles);
+    release_container(m_free_tiles);
+    release_container(m_scratch_tile.keep_outs);
+    release_container(m_scratch_tile.asteroids);
+
+    m_has_window = false;
+    m_chunk_count = 0;
+    m_rendered_count = 0;
+
+    m_level.close();
+}
+
+void World::release_storage()
+{
+    m_entities.release_storage();
+    release_container(m_entity_chunks);
+    m_sized = false;
+}
+
+void World::stream(glm::vec3 view_min, glm::vec3 view_max)
+{
+    MemoryScope scope(MEMORY_WORLD);
+    float chunk_size = m_level.get_header()->chunk_size;
+
+    // STEP 1: Size everything streaming uses for the largest window this view can produce
+    if (!m_sized)
+    {
+        m_sized = true;
+
+        int cols = (int)std::ceil((view_max.x - view_min.x) / chunk_size) + 1 + 2;
+        int rows = (int)std::ceil((view_max.y - view_min.y) / chunk_size) + 1 + 2;
+        int capacity = cols * rows * m_max_per_chunk;
+
+        {
+            MemoryScope entity_scope(MEMORY_ENTITIES);
+            m_entities.init(capacity);
+            m_entity_chunks.assign(capacity, 0);
+        }
+
+        if (m_has_field)
+        {
+            // Twice the window, so tiles the camera has already left can still be in flight
+            m_tiles.resize(2 * cols * rows);
+            m_free_tiles.clear();
+            m_free_tiles.reserve(m_tiles.size());
+            for (FieldTile& tile : m_tiles)
+            {
+                init_tile(tile);
+                m_free_tiles.push_back(&tile);
+            }
+            init_tile(m_scratch_tile);
+
+            m_pending.reserve(cols * rows);
+            m_field.start(m_field_settings, (int)m_tiles.size());
+        }
+    }
+
+    int view_min_x = (int)std::floor(view_min.x / chunk_size);
+    int view_min_y = (int)std::floor(view_min.y / chunk_size);
+    int view_max_x = (int)std::floor(view_max.x / chunk_size);
+    int view_max_y = (int)std::floor(view_max.y / chunk_size);
+
+    // Nothing to load until the camera crosses into another chunk
+    bool window_changed = !m_has_window || view_min_x - 1 != m_min_chunk_x || view_min_y - 1 != m_min_chunk_y ||
+        view_max_x + 1 != m_max_chunk_x || view_max_y + 1 != m_max_chunk_y;
+
+    if (window_changed)
+    {
+        int old_min_x = m_min_chunk_x, old_min_y = m_min_chunk_y;
+        int old_max_x = m_max_chunk_x, old_max_y = m_max_chunk_y;
+        bool had_window = m_has_window;
+
+        m_has_window = true;
+        m_min_chunk_x = view_min_x - 1;
+        m_min_chunk_y = view_min_y - 1;
+        m_max_chunk_x = view_max_x + 1;
+        m_max_chunk_y = view_max_y + 1;
+
+        // STEP 2: Unload whatever left the window
+        despawn_outside_window();
+
+        for (int i = (int)m_pending.size() - 1; i >= 0; i--)
+        {
+            if (in_window(key_x(m_pending[i].key), key_y(m_pending[i].key))) continue;
+
+            m_pending[i] = m_pending.back();
+            m_pending.pop_back();
+        }
+
+        // STEP 3: Load the chunks that entered it
+        m_chunk_count = 0;
+        for (int y = m_min_chunk_y; y <= m_max_chunk_y; y++)
+        {
+            for (int x = m_min_chunk_x; x <= m_max_chunk_x; x++)
+            {
+                const LevelChunk* chunk = m_level.get_chunk(x, y);
+                if (chunk != NULL && chunk->entity_count > 0) m_chunk_count++;
+
+                bool entered = !had_window || x < old_min_x || x > old_max_x || y < old_min_y || y > old_max_y;
+                if (entered) spawn_chunk(x, y);
+
+                if (!m_has_field) continue;
+
+                // Asteroids already on screen are needed now, the ring around them can wait for the worker
+                int64_t key = tile_key(x, y);
+                bool on_screen = x >= view_min_x && x <= view_max_x && y >= view_min_y && y <= view_max_y;
+
+                int pending = find_pending(key);
+
+                // With every tile in flight the ring is generated here too, it is only a few rocks
+                if ((on_screen || m_free_tiles.empty()) && (entered || pending >= 0))
+                {
+                    if (pending >= 0)
+                    {
+                        m_pending[pending] = m_pending.back();
+                        m_pending.pop_back();
+                    }
+                    make_tile(x, y, m_scratch_tile);
+                    AsteroidField::generate(m_field_settings, m_scratch_tile);
+                    spawn_asteroids(m_scratch_tile);
+                }
+                else if (entered)
+                {
+                    FieldTile* tile = m_free_tiles.back();
+                    m_free_tiles.pop_back();
+
+                    make_tile(x, y, *tile);
+                    tile->ticket = ++m_next_ticket;
+                    m_pending.push_back({ key, tile->ticket });
+                    m_field.request(tile);
+                }
+            }
+        }
+    }
+
+    // STEP 4: Pick up whatever the worker finished, ignoring tiles we no longer want
+    if (m_has_field)
+    {
+        FieldTile* tile;
+        while (m_field.collect(tile))
+        {
+            int pending = find_pending(tile_key(tile->x, tile->y));
+            if (pending >= 0 && m_pending[pending].ticket == tile->ticket)
+            {
+                m_pending[pending] = m_pending.back();
+                m_pending.pop_back();
+                spawn_asteroids(*tile);
+            }
+
+            m_free_tiles.push_back(tile);
+        }
+    }
+}
+
+int World::find_pending(int64_t key) const
+{
+    for (int i = 0; i < (int)m_pending.size(); i++)
+    {
+        if (m_pending[i].key == key) return i;
+    }
+    return -1;
+}
+
+void World::init_tile(FieldTile& tile) const
+{
+    // Room for the start, the goal and every stored entity in the 3x3 chunks make_tile looks at
+    tile.keep_outs.reserve(2 + 9 * m_max_stored_per_chunk);
+    tile.asteroids.reserve(m_field_settings.max_per_tile);
+}
+
+bool World::in_window(int chunk_x, int chunk_y) const
+{
+    return chunk_x >= m_min_chunk_x && chunk_x <= m_max_chunk_x && chunk_y >= m_min_chunk_y && chunk_y <= m_max_chunk_y;
+}
+
+void World::make_tile(int chunk_x, int chunk_y, FieldTile& tile) const
+{
+    const LevelHeader* header = m_level.get_header();
+    float clearance = header->field_clearance;
+
+    tile.x = chunk_x;
+    tile.y = chunk_y;
+    tile.ticket = 0;
+    tile.keep_outs.clear();
+
+    // Keep clear of the start, the goal and every stored entity that could reach into this tile
+    tile.keep_outs.push_back({ header->player_start_x, header->player_start_y, clearance });
+    tile.keep_outs.push_back({ header->goal_x, header->goal_y, clearance });
+
+    const LevelEntity* records = m_level.get_entities();
+    for (int y = chunk_y - 1; y <= chunk_y + 1; y++)
+    {
+        for (int x = chunk_x - 1; x <= chunk_x + 1; x++)
+        {
+            const LevelChunk* chunk = m_level.get_chunk(x, y);
+            if (chunk == NULL) continue;
+
+            for (uint32_t i = 0; i < chunk->entity_count; i++)
+            {
+                const LevelEntity& record = records[chunk->first_entity + i];
+                tile.keep_outs.push_back({ record.x, record.y, clearance + 0.5f * std::max(record.width, record.height) });
+            }
+        }
+    }
+}
+
+void World::spawn(EntityType type, int64_t chunk, float x, float y, float angle, float scale_x, float scale_y, float width, float height, GLuint texture_id, float mass)
+{
+    Handle handle = m_entities.allocate();
+    Entity* entity = m_entities.get(handle);
+
+    // A full pool means the view grew since streaming started; the entity just stays unloaded
+    if (entity == NULL) return;
+
+    *entity = Entity(type, true);
+    entity->set_position(glm::vec3(x, y, 0.0f));
+    entity->set_angle(angle);
+    entity->set_scale(glm::vec3(scale_x, scale_y, 1.0f), height, width);
+    entity->set_mass(mass);
+    entity->m_texture_id = texture_id;
+    entity->update(0.0f, NULL, 0);
+
+    m_entity_chunks[handle.index] = chunk;
+}
+
+void World::spawn_chunk(int chunk_x, int chunk_y)
+{
+    const LevelChunk* chunk = m_level.get_chunk(chunk_x, chunk_y);
+    if (chunk == NULL) return;
+
+    const LevelEntity* records = m_level.get_entities();
+
+    for (uint32_t i = 0; i < chunk->entity_count; i++)
+    {
+        const LevelEntity& record = records[chunk->first_entity + i];
+        GLuint texture_id = record.texture >= 0 && record.texture < (int)m_textures.size() ? m_textures[record.texture] : 0;
+
+        spawn((EntityType)record.type, tile_key(chunk_x, chunk_y), record.x, record.y, record.angle,
+            record.scale_x, record.scale_y, record.width, record.height, texture_id, 1.0f);
+    }
+}
+
+void World::spawn_asteroids(const FieldTile& tile)
+{
+    for (const Asteroid& asteroid : tile.asteroids)
+    {
+        spawn(PLATFORM, tile_key(tile.x, tile.y), asteroid.x, asteroid.y, asteroid.angle,
+            asteroid.size, asteroid.size, asteroid.size, asteroid.size, m_field_texture, asteroid.mass);
+    }
+}
+
+void World::despawn_outside_window()
+{
+    // Backwards, so whatever a release moves into the gap has already been checked
+    for (int i = m_entities.get_live_count() - 1; i >= 0; i--)
+    {
+        Handle handle = m_entities.get_handle(i);
+        int64_t chunk = m_entity_chunks[handle.index];
+
+        if (!in_window(key_x(chunk), key_y(chunk))) m_entities.release(handle);
+    }
+}
+
+void World::render(ShaderProgram* program, glm::vec3 view_min, glm::vec3 view_max)
+{
+    Entity* entities = m_entities.data();
+    m_rendered_count = 0;
+
+    for (int i = 0; i < m_entities.get_live_count(); i++)
+    {
+        if (!entities[i].in_view(view_min, view_max)) continue;
+
+        entities[i].render(program);
+        m_rendered_count++;
+    }
+}
+
+glm::vec3 World::clamp_camera(glm::vec3 camera, float half_width, float half_height) const
+{
+    const LevelHeader* header = m_level.get_header();
+
+    if (header->bounds_max_x - header->bounds_min_x <= 2.0f * half_width)
+        camera.x = (header->bounds_min_x + header->bounds_max_x) / 2.0f;
+    else
+        camera.x = std::min(std::max(camera.x, header->bounds_min_x + half_width), header->bounds_max_x - half_width);
+
+    if (header->bounds_max_y - header->bounds_min_y <= 2.0f * half_height)
+        camera.y = (header->bounds_min_y + header->bounds_max_y) / 2.0f;
+    else
+        camera.y = std::min(std::max(camera.y, header->bounds_min_y + half_height), header->bounds_max_y - half_height);
+
+    return camera;
+}
@@ -0,0 +1,96 @@
+/**
+* Author: Will Lee
+* Assignment: Lunar Lander
+* Date due: 2023-11-08, 11:59pm
+* I pledge that I have completed this assignment without
+* collaborating with anyone else, in conformance with the
+* NYU School of Engineering Policies and Procedures on
+* Academic Misconduct.
+**/
+
+#include <vector>
+
+// Streams a memory-mapped level around the camera. Only the chunks overlapping the
+// view (plus a one chunk ring, so nothing pops in at the edges) are resident. Their
+// entities live in one fixed-size Pool, sized for a full window when streaming starts,
+// so chunks come and go without heap traffic, and the pool's packed live items can be
+// handed to Entity::update as the collidable list. If the level has an asteroid field, each
+// resident chunk also gets the asteroids generated for it in the background.
+class World
+{
+private:
+    Level m_level;
+    std::vector<GLuint> m_textures;         // one per texture table entry, loaded once
+
+    Pool<Entity> m_entities;                // resident entities
+    std::vector<int64_t> m_entity_chunks;   // chunk each slot was spawned for, by Handle index
+    int m_max_per_chunk = 0;
+    int m_max_stored_per_chunk = 0;         // without the asteroids
+    bool m_sized = false;                   // whether stream() has sized the pool and tiles yet; a level can need none
+
+    // Resident chunk window, inclusive
+    bool m_has_window = false;
+    int m_min_chunk_x = 0, m_min_chunk_y = 0;
+    int m_max_chunk_x = -1, m_max_chunk_y = -1;
+    int m_chunk_count = 0;
+    int m_rendered_count = 0;
+
+    // ————— ASTEROID FIELD ————— //
+    AsteroidField m_field;
+    FieldSettings m_field_settings;
+    bool m_has_field = false;
+    GLuint m_field_texture = 0;
+    FieldTile m_scratch_tile;                   // reused for tiles generated on this thread
+
+    // Tiles sent to the worker come from here and go back once collected, keeping their
+    // capacity, so streaming never allocates. All of it is sized with the entity pool.
+    std::vector<FieldTile> m_tiles;
+    std::vector<FieldTile*> m_free_tiles;
+
+    struct PendingTile
+    {
+        int64_t key;
+        uint32_t ticket;                        // of the request we still want
+    };
+    std::vector<PendingTile> m_pending;         // at most one per tile in the window
+    uint32_t m_next_ticket = 0;
+
+    int find_pending(int64_t key) const;
+    void init_tile(FieldTile& tile) const;
+
+    bool in_window(int chunk_x, int chunk_y) const;
+    void make_tile(int chunk_x, int chunk_y, FieldTile& tile) const;
+    void spawn(EntityType type, int64_t chunk, float x, float y, float angle, float scale_x, float scale_y, float width, float height, GLuint texture_id, float mass);
+    void spawn_chunk(int chunk_x, int chunk_y);
+    void spawn_asteroids(const FieldTile& tile);
+    void despawn_outside_window();
+
+public:
+    bool open(const char* filepath, GLuint (*load_texture)(const char*));
+
+    // Stops the field worker, despawns every resident entity and gives back everything
+    // open() and stream() took, except the pool's storage so what is left can be counted
+    void close(void (*unload_texture)(GLuint));
+    void release_storage();
+
+    // Loads and unloads chunks so the resident set covers the given view rectangle
+    void stream(glm::vec3 view_min, glm::vec3 view_max);
+
+    // Draws the resident entities, skipping any that fall outside the view
+    void render(ShaderProgram* program, glm::vec3 view_min, glm::vec3 view_max);
+
+    // Keeps the view inside the level bounds, centring it on levels smaller than the view
+    glm::vec3 clamp_camera(glm::vec3 camera, float half_width, float half_height) const;
+
+    // ————— GETTERS ————— //
+    // The collidable list: only what is resident, however dense the rest of the level is
+    Entity* get_entities() { return m_entities.data(); };
+    int const get_entity_count() const { return m_entities.get_live_count(); };
+    int const get_entity_capacity() const { return m_entities.get_capacity(); };
+    const Pool<Entity>& get_pool() const { return m_entities; };
+    size_t const get_mapped_bytes() const { return m_level.get_mapped_bytes(); };
+    int const get_chunk_count() const { return m_chunk_count; };
+    int const get_rendered_count() const { return m_rendered_count; };
+    glm::vec3 const get_player_start() const { return glm::vec3(m_level.get_header()->player_start_x, m_level.get_header()->player_start_y, 0.0f); };
+    glm::vec3 const get_goal() const { return glm::vec3(m_level.get_header()->goal_x, m_level.get_header()->goal_y, 0.0f); };
+};
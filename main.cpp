@@ -10,12 +10,17 @@
 
 #define LOG(argument) std::cout << argument << '\n'
 #define STB_IMAGE_IMPLEMENTATION
+#define STBI_MALLOC(size) heap_allocate(size)
+#define STBI_REALLOC(memory, size) heap_reallocate(memory, size)
+#define STBI_FREE(memory) heap_free(memory)
 #define GL_SILENCE_DEPRECATION
 #define GL_GLEXT_PROTOTYPES 1
 #define NUMBER_OF_ENEMIES 0
 #define FIXED_TIMESTEP 0.0166666f
 #define ACC_OF_GRAVITY -1.5f
-#define PLATFORM_COUNT 11
+#define LEVEL_CHUNK_SIZE 4.0f
+#define FIELD_SEED 2023
+#define WORLD_HALF_SIZE 100.0f
 
 #ifdef _WINDOWS
 #include <GL/glew.h>
@@ -26,20 +31,24 @@
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "ShaderProgram.h"
+#include "Memory.h"
 #include "stb_image.h"
 #include "Entity.h"
+#include "Pool.h"
+#include "Resources.h"
+#include "Autopilot.h"
+#include "Level.h"
+#include "AsteroidField.h"
+#include "World.h"
 #include <vector>
 #include <ctime>
+#include <cstring>
 #include "cmath"
 
 // ————— STRUCTS AND ENUMS —————//
 struct GameState
 {
     Entity* player;
-    Entity* platforms;
-    Entity* v_plat;
-    Entity* s_plat;
-    Entity* e_list;
     Entity* fire;
     Entity* win_sc;
     Entity* lose_sc;
@@ -73,10 +82,24 @@ const char LOSE_FILEPATH[] = "assets/youdied.jpg";
 const char TEXT_FILEPATH[] = "assets/font1.png";
 const char FIRE_FILEPATH[] = "assets/fire.png";
 const char BG_FILEPATH[] = "assets/space.jpg";
+const char LEVEL_FILEPATH[] = "assets/level1.lvl";
 
 GLuint g_text_texture_id;
 
 
+const int STARTING_FUEL = 1000;
+
+// Half the size of the orthographic view, in world units
+const float VIEW_HALF_WIDTH = 5.0f,
+VIEW_HALF_HEIGHT = 3.75f;
+
+const int SCENE_ENTITY_CAPACITY = 8;
+const int ANIMATION_CAPACITY = 4;
+const size_t FRAME_ARENA_SIZE = 64 * 1024;
+
+// Frames allowed to allocate while SDL, GL and the autopilot warm up
+const int WARMUP_FRAMES = 60;
+
 const int FONTBANK_SIZE = 16;
 const int NUMBER_OF_TEXTURES = 1;
 const GLint LEVEL_OF_DETAIL = 0;
@@ -90,16 +113,40 @@ bool g_game_is_running = true;
 
 ShaderProgram g_shader_program;
 glm::mat4 g_view_matrix, g_projection_matrix;
+glm::vec3 g_camera_position = glm::vec3(0.0f);
+glm::vec3 g_view_min, g_view_max;
+
+World g_world;
+
+// ————— MEMORY ————— //
+// Scene entities and animation data live in fixed pools. Nothing is released from them
+// until shutdown, so the pointers GameState keeps never move. Anything that only has to
+// last until the frame is drawn comes from the frame arena
+Pool<Entity> g_scene_entities;
+Pool<AnimationFrames> g_animations;
+Handle g_fire_animation;
+Arena g_frame_arena;
+int g_frame_count = 0;
+bool g_autopilot_started = false;       // this frame created the autopilot's threads, the one time it may allocate
+bool g_debug_overlay = false;
 
 float g_previous_ticks = 0.0f;
 float g_time_accumulator = 0.0f;
 int g_condition = 0;
-int fuel_amount = 1000;
+int fuel_amount = STARTING_FUEL;
 bool using_fuel = false;
 
+// ————— AUTOPILOT ————— //
+Autopilot g_autopilot(FIXED_TIMESTEP, ACC_OF_GRAVITY);
+bool g_stress_test = false;
+int g_rounds_landed = 0;
+int g_rounds_crashed = 0;
+
 // ———— GENERAL FUNCTIONS ———— //
 GLuint load_texture(const char* filepath)
 {
+    MemoryScope scope(MEMORY_ASSETS);
+
     int width, height, number_of_components;
     unsigned char* image = stbi_load(filepath, &width, &height, &number_of_components, STBI_rgb_alpha);
 
@@ -122,9 +169,25 @@ GLuint load_texture(const char* filepath)
 
     stbi_image_free(image);
 
+    track_texture(textureID, width, height, filepath);
+
     return textureID;
 }
-void draw_text(ShaderProgram* program, GLuint font_texture_id, std::string text, float screen_size, float spacing, glm::vec3 position)
+
+void unload_texture(GLuint texture_id)
+{
+    glDeleteTextures(NUMBER_OF_TEXTURES, &texture_id);
+    untrack_texture(texture_id);
+}
+
+void count_all_live_entities(int counts[ENTITY_TYPE_COUNT])
+{
+    for (int i = 0; i < ENTITY_TYPE_COUNT; i++) counts[i] = 0;
+
+    count_live_entities(g_scene_entities, counts);
+    count_live_entities(g_world.get_pool(), counts);
+}
+void draw_text(ShaderProgram* program, GLuint font_texture_id, const char* text, float screen_size, float spacing, glm::vec3 position)
 {
     // Scale the size of the fontbank in the UV-plane
     // We will use this for spacing and positioning
@@ -132,12 +195,14 @@ void draw_text(ShaderProgram* program, GLuint font_texture_id, std::string text,
     float height = 1.0f / FONTBANK_SIZE;
 
     // Instead of having a single pair of arrays, we'll have a series of pairs—one for each character
-    // Don't forget to include <vector>!
-    std::vector<float> vertices;
-    std::vector<float> texture_coordinates;
+    // Both come from the frame arena, so drawing text never touches the heap
+    int length = (int)strlen(text);
+    float* vertices = g_frame_arena.allocate_array<float>(length * 12);
+    float* texture_coordinates = g_frame_arena.allocate_array<float>(length * 12);
+    if (vertices == NULL || texture_coordinates == NULL) return;
 
     // For every character...
-    for (int i = 0; i < text.size(); i++) {
+    for (int i = 0; i < length; i++) {
         // 1. Get their index in the spritesheet, as well as their offset (i.e. their position
         //    relative to the whole sentence)
         int spritesheet_index = (int)text[i];  // ascii value of character
@@ -147,24 +212,27 @@ void draw_text(ShaderProgram* program, GLuint font_texture_id, std::string text,
         float u_coordinate = (float)(spritesheet_index % FONTBANK_SIZE) / FONTBANK_SIZE;
         float v_coordinate = (float)(spritesheet_index / FONTBANK_SIZE) / FONTBANK_SIZE;
 
-        // 3. Inset the current pair in both vectors
-        vertices.insert(vertices.end(), {
+        // 3. Write the current pair into both arrays
+        float character_vertices[] = {
             offset + (-0.5f * screen_size), 0.5f * screen_size,
             offset + (-0.5f * screen_size), -0.5f * screen_size,
             offset + (0.5f * screen_size), 0.5f * screen_size,
             offset + (0.5f * screen_size), -0.5f * screen_size,
             offset + (0.5f * screen_size), 0.5f * screen_size,
             offset + (-0.5f * screen_size), -0.5f * screen_size,
-            });
+        };
 
-        texture_coordinates.insert(texture_coordinates.end(), {
+        float character_texture_coordinates[] = {
             u_coordinate, v_coordinate,
             u_coordinate, v_coordinate + height,
             u_coordinate + width, v_coordinate,
             u_coordinate + width, v_coordinate + height,
             u_coordinate + width, v_coordinate,
             u_coordinate, v_coordinate + height,
-            });
+        };
+
+        memcpy(vertices + i * 12, character_vertices, sizeof(character_vertices));
+        memcpy(texture_coordinates + i * 12, character_texture_coordinates, sizeof(character_texture_coordinates));
     }
 
     // 4. And render all of them using the pairs
@@ -174,18 +242,66 @@ void draw_text(ShaderProgram* program, GLuint font_texture_id, std::string text,
     program->set_model_matrix(model_matrix);
     glUseProgram(program->get_program_id());
 
-    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, vertices.data());
+    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, vertices);
     glEnableVertexAttribArray(program->get_position_attribute());
-    glVertexAttribPointer(program->get_tex_coordinate_attribute(), 2, GL_FLOAT, false, 0, texture_coordinates.data());
+    glVertexAttribPointer(program->get_tex_coordinate_attribute(), 2, GL_FLOAT, false, 0, texture_coordinates);
     glEnableVertexAttribArray(program->get_tex_coordinate_attribute());
 
     glBindTexture(GL_TEXTURE_2D, font_texture_id);
-    glDrawArrays(GL_TRIANGLES, 0, (int)(text.size() * 6));
+    glDrawArrays(GL_TRIANGLES, 0, length * 6);
 
     glDisableVertexAttribArray(program->get_position_attribute());
     glDisableVertexAttribArray(program->get_tex_coordinate_attribute());
 }
 
+bool write_default_level(const char* filepath)
+{
+    std::vector<std::string> textures = { END_FILEPATH, START_FILEPATH, PLATFORM_FILEPATH };
+    std::vector<LevelEntity> entities;
+
+    entities.push_back({ V_PLATFORM, 0, 3.0f, 1.5f, 0.8f, 0.8f, 1.0f, 1.0f, 0.0f });
+    entities.push_back({ S_PLATFORM, 1, -4.0f, -2.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f });
+
+    LevelHeader header = {};
+    header.chunk_size = LEVEL_CHUNK_SIZE;
+    header.player_start_x = -4.0f;
+    header.player_start_y = 2.0f;
+    header.goal_x = 3.0f;
+    header.goal_y = 1.5f;
+    header.bounds_min_x = header.bounds_min_y = -WORLD_HALF_SIZE;
+    header.bounds_max_x = header.bounds_max_y = WORLD_HALF_SIZE;
+
+    // The rocks are generated around the player instead of placed by hand
+    header.field_seed = FIELD_SEED;
+    header.field_texture = 2;
+    header.field_max_per_chunk = 3;
+    header.field_min_size = 0.4f;
+    header.field_max_size = 1.0f;
+    header.field_clearance = 1.0f;
+
+    return Level::write(filepath, header, textures, entities);
+}
+
+void update_camera()
+{
+    g_camera_position = g_world.clamp_camera(g_game_state.player->get_position(), VIEW_HALF_WIDTH, VIEW_HALF_HEIGHT);
+    g_view_matrix = glm::translate(glm::mat4(1.0f), -g_camera_position);
+
+    glm::vec3 half_view = glm::vec3(VIEW_HALF_WIDTH, VIEW_HALF_HEIGHT, 0.0f);
+    g_view_min = g_camera_position - half_view;
+    g_view_max = g_camera_position + half_view;
+    g_world.stream(g_view_min, g_view_max);
+}
+
+Entity* spawn_scene_entity(EntityType type, bool active)
+{
+    Entity* entity = g_scene_entities.get(g_scene_entities.allocate());
+    assert(entity != NULL);
+
+    *entity = Entity(type, active);
+    return entity;
+}
+
 void initialise()
 {
     SDL_Init(SDL_INIT_VIDEO);
@@ -206,7 +322,7 @@ void initialise()
     g_shader_program.load(V_SHADER_PATH, F_SHADER_PATH);
 
     g_view_matrix = glm::mat4(1.0f);
-    g_projection_matrix = glm::ortho(-5.0f, 5.0f, -3.75f, 3.75f, -1.0f, 1.0f);
+    g_projection_matrix = glm::ortho(-VIEW_HALF_WIDTH, VIEW_HALF_WIDTH, -VIEW_HALF_HEIGHT, VIEW_HALF_HEIGHT, -1.0f, 1.0f);
 
     g_shader_program.set_projection_matrix(g_projection_matrix);
     g_shader_program.set_view_matrix(g_view_matrix);
@@ -215,67 +331,71 @@ void initialise()
 
     glClearColor(BG_RED, BG_BLUE, BG_GREEN, BG_OPACITY);
 
-    g_game_state.e_list = new Entity[PLATFORM_COUNT + 2];
+    // ————— MEMORY ————— //
+    {
+        MemoryScope scope(MEMORY_ENTITIES);
+        g_scene_entities.init(SCENE_ENTITY_CAPACITY);
+        g_animations.init(ANIMATION_CAPACITY);
+    }
+    {
+        MemoryScope scope(MEMORY_TEXT);
+        g_frame_arena.init(FRAME_ARENA_SIZE);
+    }
 
     g_text_texture_id = load_texture(TEXT_FILEPATH);
 
-    g_game_state.bg = new Entity;
+    // ————— LEVEL ————— //
+    if (!g_world.open(LEVEL_FILEPATH, load_texture))
+    {
+        // First run: save the original hand-built level and load it back
+        if (!write_default_level(LEVEL_FILEPATH) || !g_world.open(LEVEL_FILEPATH, load_texture))
+        {
+            LOG("Unable to load level. Make sure the path is correct.");
+            assert(false);
+        }
+    }
+
+    g_game_state.bg = spawn_scene_entity(BG, true);
     g_game_state.bg->set_scale(glm::vec3(10.0f, 10.0f, 1.0f), 1.0f, 1.0f);
     g_game_state.bg->update(0.0f, NULL, 0);
     g_game_state.bg->m_texture_id = load_texture(BG_FILEPATH);
 
     // ————— PLAYER ————— //
 
-    g_game_state.win_sc = new Entity(SCREEN, false);
+    g_game_state.win_sc = spawn_scene_entity(SCREEN, false);
     g_game_state.win_sc->set_scale(glm::vec3(3.0f, 3.0f, 1.0f), 3.0f, 3.0f);
     g_game_state.win_sc->update(0.0f, NULL, 0);
     g_game_state.win_sc->m_texture_id = load_texture(WIN_FILEPATH);
 
-    g_game_state.lose_sc = new Entity(SCREEN, false);
+    g_game_state.lose_sc = spawn_scene_entity(SCREEN, false);
     g_game_state.lose_sc->set_scale(glm::vec3(3.0f, 3.0f, 1.0f), 3.0f, 3.0f);
     g_game_state.lose_sc->update(0.0f, NULL, 0);
     g_game_state.lose_sc->m_texture_id = load_texture(LOSE_FILEPATH);
 
-    g_game_state.player = new Entity(PLAYER, true);
-    g_game_state.player->set_position(glm::vec3(-4.0f, 2.0f, 0.0f));
+    g_game_state.player = spawn_scene_entity(PLAYER, true);
+    g_game_state.player->set_position(g_world.get_player_start());
     g_game_state.player->set_movement(glm::vec3(0.0f));
     g_game_state.player->set_acceleration(glm::vec3(0.0f, ACC_OF_GRAVITY, 0.0f));
     g_game_state.player->set_wh(0.7f, 0.5f);
     g_game_state.player->m_speed = 1.0f;
     g_game_state.player->m_texture_id = load_texture(SPRITESHEET_FILEPATH);
 
-    g_game_state.fire = new Entity(FIRE, false);
+    g_fire_animation = g_animations.allocate();
+    AnimationFrames* fire_frames = g_animations.get(g_fire_animation);
+    fire_frames->indices[0] = 0;
+    fire_frames->indices[1] = 1;
+
+    g_game_state.fire = spawn_scene_entity(FIRE, false);
     g_game_state.fire->m_animation_frames = 2;
     g_game_state.fire->m_animation_cols = 2;
     g_game_state.fire->m_animation_rows = 1;
-    g_game_state.fire->m_animation_indices = new int[2] {0, 1};
+    g_game_state.fire->m_animation_indices = fire_frames->indices;
     g_game_state.fire->set_scale(glm::vec3(0.5f, 0.5f, 0.5f), 0.5f, 0.5f);
     g_game_state.fire->m_texture_id = load_texture(FIRE_FILEPATH);
 
-    g_game_state.v_plat = new Entity(V_PLATFORM, true);
-    g_game_state.v_plat->set_position(glm::vec3(3.0f, 1.5f, 0.0f));
-    g_game_state.v_plat->set_wh(0.8f, 0.8f);
-    g_game_state.v_plat->update(0.0f, NULL, 0);
-    g_game_state.v_plat->m_texture_id = load_texture(END_FILEPATH);
-    g_game_state.e_list[0] = g_game_state.v_plat[0];
-
-    g_game_state.s_plat = new Entity(S_PLATFORM, true);
-    g_game_state.s_plat->set_position(glm::vec3(-4.0f, -2.0f, 0.0f));
-    g_game_state.v_plat->set_wh(0.8f, 0.8f);
-    g_game_state.s_plat->update(0.0f, NULL, 0);
-    g_game_state.s_plat->m_texture_id = load_texture(START_FILEPATH);
-    g_game_state.e_list[1] = g_game_state.s_plat[0];
+    update_camera();
 
-    g_game_state.platforms = new Entity[PLATFORM_COUNT];
-
-    for (int i = 0; i < PLATFORM_COUNT; i++)
-    {
-        g_game_state.platforms[i].set_type(PLATFORM, true);
-        g_game_state.platforms[i].m_texture_id = load_texture(PLATFORM_FILEPATH);
-        g_game_state.platforms[i].set_position(glm::vec3(i - 5.0f, -3.5f, 0.0f));
-        g_game_state.platforms[i].update(0.0f, NULL, 0);
-        g_game_state.e_list[2 + i] = g_game_state.platforms[i];
-    }
+    if (g_autopilot.m_is_active) g_autopilot.start(g_world.get_entity_capacity());
 
     // ————— GENERAL ————— //
     glEnable(GL_BLEND);
@@ -285,9 +405,7 @@ void initialise()
 void process_input()
 {
     // VERY IMPORTANT: If nothing is pressed, we don't want to go anywhere
-    g_game_state.player->set_movement(glm::vec3(0.0f));
-    g_game_state.player->set_acceleration(glm::vec3(0.0f, ACC_OF_GRAVITY, 0.0f));
-    g_game_state.player->set_angle_speed(glm::radians(0.0f));
+    Controls controls;
     using_fuel = false;
     g_game_state.fire->m_is_active = false;
 
@@ -302,7 +420,14 @@ void process_input()
 
         case SDL_KEYDOWN:
             switch (event.key.keysym.sym) {
-            case SDLK_ESCAPE: g_game_is_running = false;
+            case SDLK_ESCAPE: g_game_is_running = false; break;
+            case SDLK_a:
+                // Toggle the autopilot; it replans from scratch when switched on
+                g_autopilot.m_is_active = !g_autopilot.m_is_active;
+                if (g_autopilot.m_is_active) g_autopilot_started = g_autopilot.start(g_world.get_entity_capacity());
+                g_autopilot.reset();
+                break;
+            case SDLK_F3: g_debug_overlay = !g_debug_overlay; break;
             default:     break;
             }
 
@@ -311,33 +436,59 @@ void process_input()
         }
     }
 
+    // The autopilot sets the controls itself on every fixed timestep in update()
+    if (g_autopilot.m_is_active) return;
+
     const Uint8* key_state = SDL_GetKeyboardState(NULL);
 
     if (key_state[SDL_SCANCODE_LEFT])
     {
-        g_game_state.player->set_angle_speed(glm::radians(60.0f));
+        controls.turn = 1;
     }
     else if (key_state[SDL_SCANCODE_RIGHT])
     {
-        g_game_state.player->set_angle_speed(glm::radians(-60.0f));
+        controls.turn = -1;
     }
     if (key_state[SDL_SCANCODE_UP])
     {
         if (fuel_amount > 0) {
             g_game_state.fire->m_is_active = true;
-            g_game_state.player->set_acceleration(glm::vec3(-1.0f * glm::sin(g_game_state.player->get_angle()), 1.0f * glm::cos(g_game_state.player->get_angle()), 0.0f));
+            controls.thrust = true;
             using_fuel = true;
         }
     }
 
+    apply_controls(g_game_state.player, controls, ACC_OF_GRAVITY);
+
     if (glm::length(g_game_state.player->get_movement()) > 1.0f)
     {
         g_game_state.player->set_movement(glm::normalize(g_game_state.player->get_movement()));
     }
 }
 
+void reset_round()
+{
+    g_game_state.player->set_position(g_world.get_player_start());
+    g_game_state.player->set_velocity(glm::vec3(0.0f));
+    g_game_state.player->set_angle(0.0f);
+    g_game_state.player->set_cond(0);
+    g_condition = 0;
+    fuel_amount = STARTING_FUEL;
+    g_autopilot.reset();
+    update_camera();
+}
+
 void update()
 {
+    // In stress test mode a finished round just starts the next one
+    if (g_stress_test && g_condition != 0) {
+        if (g_condition == 2) g_rounds_landed++;
+        else g_rounds_crashed++;
+
+        LOG((g_condition == 2 ? "Landed" : "Crashed") << " with " << fuel_amount << " fuel left, "
+            << (int)g_autopilot.get_rollouts_per_second() << " rollouts/sec");
+        reset_round();
+    }
 
     if (g_condition == 2) {
         g_game_state.win_sc->m_is_active = true;
@@ -365,14 +516,25 @@ void update()
         // STEP 3: Once we exceed our fixed timestep, apply that elapsed time into the objects' update function invocation
         while (delta_time >= FIXED_TIMESTEP)
         {
+            if (g_autopilot.m_is_active)
+            {
+                Controls controls = g_autopilot.next_controls(g_game_state.player, g_world.get_entities(), g_world.get_entity_count(),
+                    g_world.get_goal(), fuel_amount);
+                apply_controls(g_game_state.player, controls, ACC_OF_GRAVITY);
+                g_game_state.fire->m_is_active = controls.thrust;
+                using_fuel = using_fuel || controls.thrust;
+            }
+
             // Notice that we're using FIXED_TIMESTEP as our delta time
-            g_game_state.player->update(FIXED_TIMESTEP, g_game_state.e_list, PLATFORM_COUNT + 2);
+            g_game_state.player->update(FIXED_TIMESTEP, g_world.get_entities(), g_world.get_entity_count());
             g_game_state.fire->follow(FIXED_TIMESTEP, g_game_state.player);
             delta_time -= FIXED_TIMESTEP;
         }
 
         g_time_accumulator = delta_time;
 
+        update_camera();
+
         g_condition = g_game_state.player->get_cond();
 
         if (using_fuel > 0) {
@@ -381,41 +543,148 @@ void update()
     }
 }
 
+void render_debug_overlay()
+{
+    // Everything here is formatted into the frame arena, so the overlay can stay on without allocating
+    const float size = 0.15f, line = 0.2f, x = -4.8f;
+    float y = 1.8f;
+
+    for (int i = 0; i < MEMORY_SUBSYSTEM_COUNT; i++, y -= line)
+    {
+        MemorySubsystem subsystem = (MemorySubsystem)i;
+        draw_text(&g_shader_program, g_text_texture_id, g_frame_arena.format("%-8s %6lld KB %5lld", MEMORY_SUBSYSTEM_NAMES[i],
+            heap_bytes(subsystem) / 1024, heap_allocations(subsystem)), size, 0.0f, glm::vec3(x, y, 0.0f));
+    }
+
+    draw_text(&g_shader_program, g_text_texture_id, g_frame_arena.format("TEXTURES %d %lld KB", tracked_texture_count(), tracked_texture_bytes() / 1024),
+        size, 0.0f, glm::vec3(x, y, 0.0f));
+    y -= line;
+    draw_text(&g_shader_program, g_text_texture_id, g_frame_arena.format("BUFFERS %d %lld KB", tracked_buffer_count(), tracked_buffer_bytes() / 1024),
+        size, 0.0f, glm::vec3(x, y, 0.0f));
+    y -= line;
+    draw_text(&g_shader_program, g_text_texture_id, g_frame_arena.format("LEVEL %d KB MAPPED", (int)(g_world.get_mapped_bytes() / 1024)),
+        size, 0.0f, glm::vec3(x, y, 0.0f));
+    y -= line;
+    draw_text(&g_shader_program, g_text_texture_id, g_frame_arena.format("ARENA %d/%d KB", (int)(g_frame_arena.get_peak() / 1024), (int)(g_frame_arena.get_capacity() / 1024)),
+        size, 0.0f, glm::vec3(x, y, 0.0f));
+    y -= line;
+
+    int counts[ENTITY_TYPE_COUNT];
+    count_all_live_entities(counts);
+    for (int i = 0; i < ENTITY_TYPE_COUNT; i++, y -= line)
+    {
+        draw_text(&g_shader_program, g_text_texture_id, g_frame_arena.format("%-10s %d", ENTITY_TYPE_NAMES[i], counts[i]),
+            size, 0.0f, glm::vec3(x, y, 0.0f));
+    }
+}
+
 void render()
 {
     glClear(GL_COLOR_BUFFER_BIT);
 
+    // The background and HUD stay fixed to the screen; only the world scrolls
+    g_shader_program.set_view_matrix(glm::mat4(1.0f));
     g_game_state.bg->render(&g_shader_program);
-    g_game_state.player->render(&g_shader_program);
-    g_game_state.fire->render(&g_shader_program);
 
-    for (int i = 0; i < PLATFORM_COUNT; i++) {
-        g_game_state.platforms[i].render(&g_shader_program);
+    g_shader_program.set_view_matrix(g_view_matrix);
+    if (g_game_state.player->in_view(g_view_min, g_view_max)) {
+        g_game_state.player->render(&g_shader_program);
+        g_game_state.fire->render(&g_shader_program);
     }
+    g_world.render(&g_shader_program, g_view_min, g_view_max);
 
-    g_game_state.v_plat->render(&g_shader_program);
-    g_game_state.s_plat->render(&g_shader_program);
+    g_shader_program.set_view_matrix(glm::mat4(1.0f));
     g_game_state.win_sc->render(&g_shader_program);
     g_game_state.lose_sc->render(&g_shader_program);
 
-    draw_text(&g_shader_program, g_text_texture_id, std::string("REMAINING FUEL:"), 0.25f, 0.0f, glm::vec3(-4.5f, 3.0f, 0.0f));
-    draw_text(&g_shader_program, g_text_texture_id, std::string(std::to_string(fuel_amount)), 0.25f, 0.01f, glm::vec3(-4.0f, 2.5f, 0.0f));
+    draw_text(&g_shader_program, g_text_texture_id, "REMAINING FUEL:", 0.25f, 0.0f, glm::vec3(-4.5f, 3.0f, 0.0f));
+    draw_text(&g_shader_program, g_text_texture_id, g_frame_arena.format("%d", fuel_amount), 0.25f, 0.01f, glm::vec3(-4.0f, 2.5f, 0.0f));
+
+    if (g_autopilot.m_is_active) {
+        draw_text(&g_shader_program, g_text_texture_id, "ROLLOUTS/SEC:", 0.25f, 0.0f, glm::vec3(1.0f, 3.0f, 0.0f));
+        draw_text(&g_shader_program, g_text_texture_id, g_frame_arena.format("%d", (int)g_autopilot.get_rollouts_per_second()), 0.25f, 0.01f, glm::vec3(1.5f, 2.5f, 0.0f));
+    }
+
+    if (g_debug_overlay) render_debug_overlay();
 
     SDL_GL_SwapWindow(g_display_window);
 }
 
-void shutdown() { SDL_Quit(); }
+void shutdown()
+{
+    if (g_autopilot.get_total_rollouts() > 0) {
+        LOG("Autopilot: " << g_autopilot.get_total_rollouts() << " rollouts on " << g_autopilot.get_thread_count()
+            << " threads, " << (int)g_autopilot.get_average_rollouts_per_second() << " rollouts/sec average");
+    }
+    if (g_stress_test) {
+        LOG("Stress test: " << g_rounds_landed << " landed, " << g_rounds_crashed << " crashed");
+    }
+
+    // ————— RESOURCES ————— //
+    // STEP 1: Give back everything we own, so whatever the report still finds has leaked
+    g_world.close(unload_texture);
+
+    unload_texture(g_text_texture_id);
+    unload_texture(g_game_state.bg->m_texture_id);
+    unload_texture(g_game_state.win_sc->m_texture_id);
+    unload_texture(g_game_state.lose_sc->m_texture_id);
+    unload_texture(g_game_state.player->m_texture_id);
+    unload_texture(g_game_state.fire->m_texture_id);
+
+    // Releasing moves other entities in the pool, so take every handle before releasing any
+    Handle scene_handles[] = {
+        g_scene_entities.get_handle(g_game_state.player),
+        g_scene_entities.get_handle(g_game_state.fire),
+        g_scene_entities.get_handle(g_game_state.win_sc),
+        g_scene_entities.get_handle(g_game_state.lose_sc),
+        g_scene_entities.get_handle(g_game_state.bg),
+    };
+    for (Handle handle : scene_handles) g_scene_entities.release(handle);
+    g_animations.release(g_fire_animation);
+    g_game_state = GameState();
+
+    // STEP 2: Count what is still live while the pools exist...
+    int counts[ENTITY_TYPE_COUNT];
+    count_all_live_entities(counts);
+
+    // STEP 3: ...then free their storage, so the heap report only shows memory nobody gave back
+    g_world.release_storage();
+    g_scene_entities.release_storage();
+    g_animations.release_storage();
+    g_frame_arena.release();
+
+    print_resource_report(counts, true);
+
+    SDL_Quit();
+}
 
 // ————— DRIVER GAME LOOP ————— /
 int main(int argc, char* argv[])
 {
+    // --autopilot starts with the autopilot flying, --stress also restarts every finished round
+    // and keeps the planner searching flat out, so its rollouts/sec is a sustained figure
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--autopilot") == 0) g_autopilot.m_is_active = true;
+        if (strcmp(argv[i], "--stress") == 0) g_autopilot.m_is_active = g_autopilot.m_sustained = g_stress_test = true;
+    }
+
     initialise();
 
     while (g_game_is_running)
     {
+        long long allocations = thread_allocation_count();
+        g_autopilot_started = false;
+        g_frame_arena.reset();
+
         process_input();
         update();
         render();
+
+        // Once warmed up, no frame may touch the heap, streaming included; the only
+        // exception is the frame that switched the autopilot on for the first time
+        g_frame_count++;
+        assert(g_frame_count <= WARMUP_FRAMES || g_autopilot_started || thread_allocation_count() == allocations);
     }
 
     shutdown();